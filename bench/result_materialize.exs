@@ -0,0 +1,56 @@
+# Compares Adbc.Result.materialize/2, which decodes the columns of a result
+# in parallel, with materializing each column on its own, for results with
+# more and more columns of the same size.
+#
+#     mix run bench/result_materialize.exs
+#
+# The speedup grows with the number of columns up to the number of
+# schedulers, which is the number of threads that decode the columns.
+
+rows = 1_000_000
+runs = 5
+
+{:ok, db} = Adbc.Database.start_link(driver: :sqlite, uri: ":memory:")
+{:ok, conn} = Adbc.Connection.start_link(database: db)
+
+measure = fn fun ->
+  fun.()
+
+  1..runs
+  |> Enum.map(fn _ -> fun.() |> elem(0) end)
+  |> Enum.sort()
+  |> Enum.at(div(runs, 2))
+end
+
+IO.puts("schedulers: #{System.schedulers_online()}, rows per column: #{rows}\n")
+IO.puts("columns  serial (ms)  parallel (ms)  speedup")
+
+for n_columns <- [1, 2, 4, 8, 16] do
+  columns =
+    Enum.map_join(1..n_columns, ", ", fn column_i ->
+      if rem(column_i, 2) == 0,
+        do: "'s' || x AS c#{column_i}",
+        else: "x * #{column_i} AS c#{column_i}"
+    end)
+
+  {:ok, result} =
+    Adbc.Connection.query(
+      conn,
+      "WITH RECURSIVE t(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM t WHERE x < #{rows}) " <>
+        "SELECT #{columns} FROM t"
+    )
+
+  serial =
+    measure.(fn ->
+      :timer.tc(fn -> %{result | data: Enum.map(result.data, &Adbc.Column.materialize/1)} end)
+    end)
+
+  parallel = measure.(fn -> :timer.tc(fn -> Adbc.Result.materialize(result) end) end)
+
+  IO.puts(
+    String.pad_leading("#{n_columns}", 7) <>
+      String.pad_leading("#{div(serial, 1000)}", 13) <>
+      String.pad_leading("#{div(parallel, 1000)}", 15) <>
+      String.pad_leading(:erlang.float_to_binary(serial / parallel, decimals: 2), 9)
+  )
+end
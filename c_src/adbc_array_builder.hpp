@@ -0,0 +1,353 @@
+#ifndef ADBC_ARRAY_BUILDER_HPP
+#define ADBC_ARRAY_BUILDER_HPP
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <erl_nif.h>
+#include <nanoarrow/nanoarrow.h>
+
+// The appenders below write the values of an array that is being built
+// straight into its buffers, instead of going through `ArrowArrayAppend*`,
+// which switches on the storage type and checks the capacity of every
+// buffer for each value.
+//
+// `reserve` makes room for `n_items` more values, after which exactly
+// `n_items` values (or nulls) must be appended, the fixed-width buffers
+// are written without bounds checks.
+//
+// Like nanoarrow, the validity bitmap is only allocated at the first null,
+// so arrays without nulls are still finished without one.
+
+/// Keeps the length, null count and validity bitmap of the array up to date
+struct AdbcValidityAppender {
+    struct ArrowArray * array = nullptr;
+    struct ArrowBitmap * validity = nullptr;
+    // number of values `reserve` made room for that are not appended yet
+    int64_t remaining = 0;
+
+    int reserve(struct ArrowArray * array, int64_t n_items) {
+        this->array = array;
+        this->validity = ArrowArrayValidityBitmap(array);
+        this->remaining = n_items;
+        return ArrowArrayReserve(array, n_items);
+    }
+
+    inline void finish_valid() {
+        if (this->validity->buffer.data != nullptr) {
+            ArrowBitmapAppendUnsafe(this->validity, 1, 1);
+        }
+        this->array->length++;
+        this->remaining--;
+    }
+
+    inline int finish_null() {
+        if (this->validity->buffer.data == nullptr) {
+            NANOARROW_RETURN_NOT_OK(ArrowBitmapReserve(this->validity, this->array->length + this->remaining));
+            ArrowBitmapAppendUnsafe(this->validity, 1, this->array->length);
+        }
+        ArrowBitmapAppendUnsafe(this->validity, 0, 1);
+        this->array->length++;
+        this->array->null_count++;
+        this->remaining--;
+        return 0;
+    }
+};
+
+/// Appends values of the C type `T` to an array with that storage type,
+/// `bool` values are bit-packed
+template <typename T> struct AdbcFixedWidthAppender : AdbcValidityAppender {
+    struct ArrowBuffer * data = nullptr;
+
+    int reserve(struct ArrowArray * array, int64_t n_items) {
+        this->data = ArrowArrayBuffer(array, 1);
+        return AdbcValidityAppender::reserve(array, n_items);
+    }
+
+    inline void append(T value) {
+        this->write(value);
+        this->finish_valid();
+    }
+
+    /// Appends `value` if it is representable as `T`, like `ArrowArrayAppendInt`
+    ///
+    /// @return `EINVAL` if it is not
+    inline int append_checked(int64_t value) {
+        static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "append_checked is only for signed integers");
+        if (value < (int64_t)std::numeric_limits<T>::min() || value > (int64_t)std::numeric_limits<T>::max()) {
+            return EINVAL;
+        }
+        this->append((T)value);
+        return 0;
+    }
+
+    inline int append_null() {
+        this->write(T{});
+        return this->finish_null();
+    }
+
+private:
+    inline void write(T value) {
+        if constexpr (std::is_same<T, bool>::value) {
+            int64_t i = this->array->offset + this->array->length;
+            if (i % 8 == 0) {
+                uint8_t zero = 0;
+                ArrowBufferAppendUnsafe(this->data, &zero, 1);
+            }
+            if (value) {
+                ArrowBitSet(this->data->data, i);
+            }
+        } else {
+            ArrowBufferAppendUnsafe(this->data, &value, sizeof(T));
+        }
+    }
+};
+
+/// Appends values of `width` bytes each, for fixed size binaries,
+/// decimals and intervals
+struct AdbcFixedSizeBinaryAppender : AdbcValidityAppender {
+    struct ArrowBuffer * data = nullptr;
+    int64_t width = 0;
+
+    int reserve(struct ArrowArray * array, int64_t width, int64_t n_items) {
+        this->data = ArrowArrayBuffer(array, 1);
+        this->width = width;
+        return AdbcValidityAppender::reserve(array, n_items);
+    }
+
+    inline void append(const void * bytes) {
+        ArrowBufferAppendUnsafe(this->data, bytes, this->width);
+        this->finish_valid();
+    }
+
+    inline int append_null() {
+        memset(this->data->data + this->data->size_bytes, 0, (size_t)this->width);
+        this->data->size_bytes += this->width;
+        return this->finish_null();
+    }
+};
+
+/// Appends to a string or binary array with offsets of type `Offset`
+///
+/// Only the offsets and the validity bitmap are reserved by `reserve`, the
+/// data buffer grows as the values are appended unless `reserve_data` made
+/// room for all of them before.
+template <typename Offset> struct AdbcVarBinaryAppender : AdbcValidityAppender {
+    struct ArrowBuffer * offsets = nullptr;
+    struct ArrowBuffer * data = nullptr;
+
+    int reserve(struct ArrowArray * array, int64_t n_items) {
+        this->offsets = ArrowArrayBuffer(array, 1);
+        this->data = ArrowArrayBuffer(array, 2);
+        return AdbcValidityAppender::reserve(array, n_items);
+    }
+
+    /// Makes room for `nbytes` more bytes of values, so that the data buffer
+    /// is allocated once instead of growing value by value
+    int reserve_data(int64_t nbytes) {
+        if (nbytes > (int64_t)std::numeric_limits<Offset>::max()) {
+            // `append` will fail before the buffer fills up
+            return 0;
+        }
+        return ArrowBufferReserve(this->data, nbytes);
+    }
+
+    /// @return `EOVERFLOW` if the data would not be addressable with `Offset` anymore
+    inline int append(const uint8_t * bytes, int64_t nbytes) {
+        int64_t end = this->data->size_bytes + nbytes;
+        if (end > (int64_t)std::numeric_limits<Offset>::max()) {
+            return EOVERFLOW;
+        }
+        NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(this->data, bytes, nbytes));
+        Offset offset = (Offset)end;
+        ArrowBufferAppendUnsafe(this->offsets, &offset, sizeof(Offset));
+        this->finish_valid();
+        return 0;
+    }
+
+    inline int append_null() {
+        Offset offset = (Offset)this->data->size_bytes;
+        ArrowBufferAppendUnsafe(this->offsets, &offset, sizeof(Offset));
+        return this->finish_null();
+    }
+};
+
+static void adbc_binary_buffer_free(struct ArrowBufferAllocator * allocator, uint8_t * ptr, int64_t size) {
+    enif_free_env((ErlNifEnv *)allocator->private_data);
+}
+
+static void adbc_binary_buffer_keep(struct ArrowBufferAllocator * allocator, uint8_t * ptr, int64_t size) {
+}
+
+/// Appends to a binary or string view array, referencing the bytes of the
+/// values that do not fit into their view instead of copying them.
+///
+/// Those values are binaries larger than the ones the VM keeps on the
+/// process heap, which are reference-counted and never move: they are
+/// copied into an environment of the array's own, which only takes a
+/// reference, and that environment is freed with the array.
+///
+/// A variadic buffer spans values that lie next to each other in memory,
+/// such as the parts of a binary that was split in Elixir, and a new one is
+/// started whenever the next value lies elsewhere. Shorter binaries and
+/// iolists are copied into a variadic buffer of the array's own instead.
+struct AdbcBinaryViewAppender : AdbcValidityAppender {
+    // binaries up to this size may live on a process heap, see `ERL_ONHEAP_BIN_LIMIT`
+    static constexpr size_t kMaxHeapBinarySize = 64;
+
+    struct ArrowBuffer * views = nullptr;
+    ErlNifEnv * owner = nullptr;
+    // index of the variadic buffer the referenced values go to and its bounds
+    int32_t referenced_index = -1;
+    const uint8_t * referenced_start = nullptr;
+    const uint8_t * referenced_end = nullptr;
+    // index of the variadic buffer the copied values go to
+    int32_t copied_index = -1;
+
+    int reserve(struct ArrowArray * array, int64_t n_items) {
+        this->views = ArrowArrayBuffer(array, 1);
+        NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(this->views, n_items * (int64_t)sizeof(union ArrowBinaryView)));
+        return AdbcValidityAppender::reserve(array, n_items);
+    }
+
+    /// Appends `value`, a binary or an iolist
+    ///
+    /// @return 1 if `value` is neither, `EOVERFLOW` if it is longer than a
+    /// view can address
+    inline int append(ErlNifEnv *env, ERL_NIF_TERM value) {
+        ErlNifBinary bytes;
+        bool is_binary = enif_inspect_binary(env, value, &bytes);
+        if (!is_binary && !enif_inspect_iolist_as_binary(env, value, &bytes)) {
+            return 1;
+        }
+        if (bytes.size > (size_t)std::numeric_limits<int32_t>::max()) {
+            return EOVERFLOW;
+        }
+
+        union ArrowBinaryView view;
+        memset(&view, 0, sizeof(view));
+        view.inlined.size = (int32_t)bytes.size;
+        if (bytes.size <= NANOARROW_BINARY_VIEW_INLINE_SIZE) {
+            memcpy(view.inlined.data, bytes.data, bytes.size);
+        } else {
+            memcpy(view.ref.prefix, bytes.data, NANOARROW_BINARY_VIEW_PREFIX_SIZE);
+            if (is_binary && bytes.size > kMaxHeapBinarySize) {
+                NANOARROW_RETURN_NOT_OK(this->reference(value, (int64_t)bytes.size, view));
+            } else {
+                NANOARROW_RETURN_NOT_OK(this->copy(bytes.data, (int64_t)bytes.size, view));
+            }
+        }
+        ArrowBufferAppendUnsafe(this->views, &view, sizeof(view));
+        this->finish_valid();
+        return 0;
+    }
+
+    inline int append_null() {
+        union ArrowBinaryView view;
+        memset(&view, 0, sizeof(view));
+        ArrowBufferAppendUnsafe(this->views, &view, sizeof(view));
+        return this->finish_null();
+    }
+
+private:
+    struct ArrowArrayPrivateData * private_data() {
+        return (struct ArrowArrayPrivateData *)this->array->private_data;
+    }
+
+    /// Adds an empty variadic buffer to the array that frees its data with `allocator`
+    int add_buffer(struct ArrowBufferAllocator allocator, int32_t * index) {
+        NANOARROW_RETURN_NOT_OK(ArrowArrayAddVariadicBuffers(this->array, 1));
+        *index = this->private_data()->n_variadic_buffers - 1;
+        this->private_data()->variadic_buffers[*index].allocator = allocator;
+        return 0;
+    }
+
+    int reference(ERL_NIF_TERM value, int64_t nbytes, union ArrowBinaryView &view) {
+        if (this->owner == nullptr) {
+            // the first referencing buffer frees the environment, the ones
+            // added after it have nothing to free
+            ErlNifEnv * owner = enif_alloc_env();
+            int ret = this->add_buffer(ArrowBufferDeallocator(adbc_binary_buffer_free, owner), &this->referenced_index);
+            if (ret != 0) {
+                enif_free_env(owner);
+                return ret;
+            }
+            this->owner = owner;
+        }
+
+        ErlNifBinary kept;
+        enif_inspect_binary(this->owner, enif_make_copy(this->owner, value), &kept);
+        const uint8_t * start = kept.data;
+        const uint8_t * end = kept.data + nbytes;
+        if (this->referenced_start != nullptr
+            && start >= this->referenced_start && start <= this->referenced_end
+            && end - this->referenced_start <= std::numeric_limits<int32_t>::max()) {
+            if (end > this->referenced_end) {
+                this->referenced_end = end;
+            }
+        } else {
+            if (this->referenced_start != nullptr) {
+                NANOARROW_RETURN_NOT_OK(this->add_buffer(ArrowBufferDeallocator(adbc_binary_buffer_keep, nullptr), &this->referenced_index));
+            }
+            this->referenced_start = start;
+            this->referenced_end = end;
+        }
+
+        struct ArrowBuffer * buffer = &this->private_data()->variadic_buffers[this->referenced_index];
+        buffer->data = (uint8_t *)this->referenced_start;
+        buffer->size_bytes = (int64_t)(this->referenced_end - this->referenced_start);
+        buffer->capacity_bytes = buffer->size_bytes;
+        this->private_data()->variadic_buffer_sizes[this->referenced_index] = buffer->size_bytes;
+
+        view.ref.buffer_index = this->referenced_index;
+        view.ref.offset = (int32_t)(start - this->referenced_start);
+        return 0;
+    }
+
+    int copy(const uint8_t * bytes, int64_t nbytes, union ArrowBinaryView &view) {
+        if (this->copied_index == -1
+            || this->private_data()->variadic_buffers[this->copied_index].size_bytes + nbytes > std::numeric_limits<int32_t>::max()) {
+            NANOARROW_RETURN_NOT_OK(this->add_buffer(ArrowBufferAllocatorDefault(), &this->copied_index));
+        }
+
+        struct ArrowBuffer * buffer = &this->private_data()->variadic_buffers[this->copied_index];
+        view.ref.buffer_index = this->copied_index;
+        view.ref.offset = (int32_t)buffer->size_bytes;
+        NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(buffer, bytes, nbytes));
+        this->private_data()->variadic_buffer_sizes[this->copied_index] = buffer->size_bytes;
+        return 0;
+    }
+};
+
+/// Makes `buffer` point at the bytes of the binary `binary_term` instead
+/// of a copy of them.
+///
+/// The binary is copied into an environment of its own, which for
+/// reference-counted binaries only takes a reference, and that environment
+/// is freed when the buffer is, so the bytes stay valid until the array the
+/// buffer is moved into gets released, on whichever thread that happens.
+///
+/// @return 0 on success, 1 if `binary_term` is not a binary, is empty, or
+/// if its bytes are not aligned to `alignment`, in which case `buffer` is
+/// left as it was
+static int adbc_buffer_wrap_binary(ErlNifEnv *env, ERL_NIF_TERM binary_term, size_t alignment, struct ArrowBuffer * buffer) {
+    ErlNifEnv * owner = enif_alloc_env();
+    ERL_NIF_TERM kept = enif_make_copy(owner, binary_term);
+    ErlNifBinary bytes;
+    if (!enif_inspect_binary(owner, kept, &bytes) || bytes.size == 0 || ((uintptr_t)bytes.data % alignment) != 0) {
+        enif_free_env(owner);
+        return 1;
+    }
+
+    ArrowBufferReset(buffer);
+    buffer->data = bytes.data;
+    buffer->size_bytes = (int64_t)bytes.size;
+    buffer->capacity_bytes = (int64_t)bytes.size;
+    buffer->allocator = ArrowBufferDeallocator(adbc_binary_buffer_free, owner);
+    return 0;
+}
+
+#endif  // ADBC_ARRAY_BUILDER_HPP
@@ -3,86 +3,102 @@
 #pragma once
 
 #include <stdio.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdbool>
 #include <cstdint>
 #include <vector>
 #include <arrow-adbc/adbc.h>
 #include <erl_nif.h>
+#include "adbc_bitmap.hpp"
+#include "adbc_calendar.hpp"
+#include "adbc_decimal.hpp"
 #include "adbc_half_float.hpp"
+#include "adbc_string_interner.hpp"
 #include "adbc_arrow_metadata.hpp"
+#include "adbc_materialize_options.hpp"
 
-static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false);
-static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false);
+static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false, const AdbcMaterializeOptions * options = nullptr);
+static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
-static int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
+static int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
-static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
+static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
+static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, ArrowType list_type, unsigned n_items = 0);
-static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items = 0);
+static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items = 0, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
+static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
 static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
+static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr);
+
+/// Makes the list of `values` followed by the elements of the list `tail`,
+/// or only of `values` if `tail` is 0.
+///
+/// The list is built from its last cell, so that decoded values can be
+/// prepended to the values decoded so far without an intermediate list.
+static ERL_NIF_TERM make_list_with_tail(ErlNifEnv *env, const std::vector<ERL_NIF_TERM> &values, ERL_NIF_TERM tail) {
+    if (tail == 0) {
+        return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
+    }
+    for (size_t i = values.size(); i > 0; i--) {
+        tail = enif_make_list_cell(env, values[i - 1], tail);
+    }
+    return tail;
+}
 
 template <typename M> static ERL_NIF_TERM bit_boolean_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * value_buffer, const M& value_to_nif) {
+    const ERL_NIF_TERM terms[2] = { value_to_nif(env, false), value_to_nif(env, true) };
     std::vector<ERL_NIF_TERM> values(count);
-    for (int64_t i = offset; i < offset + count; i++) {
-        uint8_t vbyte = value_buffer[i/8];
-        values[i - offset] = value_to_nif(env, vbyte & (1 << (i % 8)));
-    }
+    adbc_bitmap_unpack(value_buffer, offset, count, terms, values.data());
     return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
 }
 
-static ERL_NIF_TERM boolean_values_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * validity_bitmap, const bool * value_buffer) {
+static ERL_NIF_TERM boolean_values_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * validity_bitmap, const bool * value_buffer, ERL_NIF_TERM tail = 0) {
+    const ERL_NIF_TERM terms[2] = { kAtomFalse, kAtomTrue };
     std::vector<ERL_NIF_TERM> values(count);
-    if (validity_bitmap == nullptr) {
-        for (int64_t i = offset; i < offset + count; i++) {
-            uint8_t dbyte = value_buffer[i/8];
-            bool boolean_val = dbyte & (1 << (i % 8));
-            values[i - offset] = boolean_val ? kAtomTrue : kAtomFalse;
-        }
-    } else {
-        for (int64_t i = offset; i < offset + count; i++) {
-            uint8_t vbyte = validity_bitmap[i/8];
-            uint8_t mask = 1 << (i % 8);
-            if (vbyte & mask) {
-                uint8_t dbyte = value_buffer[i/8];
-                bool boolean_val = dbyte & mask;
-                values[i - offset] = boolean_val ? kAtomTrue : kAtomFalse;
-            } else {
-                values[i - offset] = kAtomNil;
+    adbc_bitmap_unpack((const uint8_t *)value_buffer, offset, count, terms, values.data());
+    if (validity_bitmap != nullptr) {
+        adbc_bitmap_visit_runs(validity_bitmap, offset, count,
+            [](int64_t, int64_t) {},
+            [&](int64_t begin, int64_t end) {
+                std::fill(values.begin() + (begin - offset), values.begin() + (end - offset), kAtomNil);
             }
-        }
+        );
     }
 
-    return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
+    return make_list_with_tail(env, values, tail);
 }
 
 static ERL_NIF_TERM boolean_values_from_buffer(ErlNifEnv *env, int64_t length, const uint8_t * validity_bitmap, const bool * value_buffer) {
     return boolean_values_from_buffer(env, 0, length, validity_bitmap, value_buffer);
 }
 
-template <typename T, typename M> static ERL_NIF_TERM values_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * validity_bitmap, const T * value_buffer, const M& value_to_nif) {
-    std::vector<ERL_NIF_TERM> values(count);
+/// Calls `on_valid(begin, end)` for each run of non-null values in
+/// `[offset, offset + count)`, and sets the terms of the null ones in
+/// `values`, which holds the terms of that range, to nil
+template <typename V> static void visit_valid_runs(int64_t offset, int64_t count, const uint8_t * validity_bitmap, std::vector<ERL_NIF_TERM> &values, const V& on_valid) {
     if (validity_bitmap == nullptr) {
-        for (int64_t i = offset; i < offset + count; i++) {
-            values[i - offset] = value_to_nif(env, value_buffer[i]);
+        on_valid(offset, offset + count);
+        return;
+    }
+    adbc_bitmap_visit_runs(validity_bitmap, offset, count, on_valid,
+        [&](int64_t begin, int64_t end) {
+            std::fill(values.begin() + (begin - offset), values.begin() + (end - offset), kAtomNil);
         }
-    } else {
-        for (int64_t i = offset; i < offset + count; i++) {
-            uint8_t vbyte = validity_bitmap[i/8];
-            if (vbyte & (1 << (i % 8))) {
-                values[i - offset] = value_to_nif(env, value_buffer[i]);
-            } else {
-                values[i - offset] = kAtomNil;
-            }
+    );
+}
+
+template <typename T, typename M> static ERL_NIF_TERM values_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * validity_bitmap, const T * value_buffer, const M& value_to_nif, ERL_NIF_TERM tail = 0) {
+    std::vector<ERL_NIF_TERM> values(count);
+    visit_valid_runs(offset, count, validity_bitmap, values, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            values[i - offset] = value_to_nif(env, value_buffer[i]);
         }
-    }
+    });
 
-    return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
+    return make_list_with_tail(env, values, tail);
 }
 
 template <typename T, typename M> static ERL_NIF_TERM values_from_buffer(ErlNifEnv *env, int64_t length, const uint8_t * validity_bitmap, const T * value_buffer, const M& value_to_nif) {
@@ -96,11 +112,12 @@ template <typename M, typename OffsetT> static ERL_NIF_TERM strings_from_buffer(
     const uint8_t * validity_bitmap,
     const OffsetT * offsets_buffer,
     const uint8_t* value_buffer,
-    const M& value_to_nif) {
-    OffsetT offset = offsets_buffer[element_offset];
+    const M& value_to_nif,
+    ERL_NIF_TERM tail = 0) {
     std::vector<ERL_NIF_TERM> values(element_count);
-    if (validity_bitmap == nullptr) {
-        for (int64_t i = element_offset; i < element_offset + element_count; i++) {
+    visit_valid_runs(element_offset, element_count, validity_bitmap, values, [&](int64_t begin, int64_t end) {
+        OffsetT offset = offsets_buffer[begin];
+        for (int64_t i = begin; i < end; i++) {
             OffsetT end_index = offsets_buffer[i + 1];
             size_t nbytes = end_index - offset;
             if (nbytes == 0) {
@@ -110,21 +127,9 @@ template <typename M, typename OffsetT> static ERL_NIF_TERM strings_from_buffer(
             }
             offset = end_index;
         }
-    } else {
-        for (int64_t i = element_offset; i < element_offset + element_count; i++) {
-            uint8_t vbyte = validity_bitmap[i / 8];
-            OffsetT end_index = offsets_buffer[i + 1];
-            size_t nbytes = end_index - offset;
-            if (nbytes > 0 && vbyte & (1 << (i % 8))) {
-                values[i - element_offset] = value_to_nif(env, value_buffer, offset, nbytes);
-            } else {
-                values[i - element_offset] = kAtomNil;
-            }
-            offset = end_index;
-        }
-    }
+    });
 
-    return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
+    return make_list_with_tail(env, values, tail);
 }
 
 template <typename M, typename OffsetT> static ERL_NIF_TERM strings_from_buffer(
@@ -137,6 +142,165 @@ template <typename M, typename OffsetT> static ERL_NIF_TERM strings_from_buffer(
     return strings_from_buffer(env, 0, length, validity_bitmap, offsets_buffer, value_buffer, value_to_nif);
 }
 
+/// Like `strings_from_buffer`, but repeated values share one term
+/// when `options` asks for it, see `AdbcMaterializeOptions::interner`
+template <typename M, typename OffsetT> static ERL_NIF_TERM interned_strings_from_buffer(
+    ErlNifEnv *env,
+    int64_t element_offset,
+    int64_t element_count,
+    const uint8_t * validity_bitmap,
+    const OffsetT * offsets_buffer,
+    const uint8_t* value_buffer,
+    const AdbcMaterializeOptions * options,
+    const M& value_to_nif,
+    ERL_NIF_TERM tail = 0) {
+    if (options == nullptr || !options->intern_strings) {
+        return strings_from_buffer(env, element_offset, element_count, validity_bitmap, offsets_buffer, value_buffer, value_to_nif, tail);
+    }
+
+    AdbcStringInterner &interner = options->interner;
+    return strings_from_buffer(
+        env,
+        element_offset,
+        element_count,
+        validity_bitmap,
+        offsets_buffer,
+        value_buffer,
+        [&](ErlNifEnv *env, const uint8_t * string_buffers, OffsetT offset, size_t nbytes) -> ERL_NIF_TERM {
+            return interner.intern(string_buffers + offset, nbytes, [&]() -> ERL_NIF_TERM {
+                return value_to_nif(env, string_buffers, offset, nbytes);
+            });
+        },
+        tail
+    );
+}
+
+template <typename OffsetT> static ERL_NIF_TERM binaries_from_buffer(
+    ErlNifEnv *env,
+    int64_t element_offset,
+    int64_t element_count,
+    const uint8_t * validity_bitmap,
+    const OffsetT * offsets_buffer,
+    const uint8_t* value_buffer,
+    const AdbcMaterializeOptions * options,
+    ERL_NIF_TERM tail = 0) {
+    ERL_NIF_TERM parent;
+    OffsetT parent_start = offsets_buffer[element_offset];
+    size_t parent_nbytes = offsets_buffer[element_offset + element_count] - parent_start;
+    if (element_count > 0 && make_zero_copy_binary(env, options, value_buffer + parent_start, parent_nbytes, parent)) {
+        return interned_strings_from_buffer(
+            env,
+            element_offset,
+            element_count,
+            validity_bitmap,
+            offsets_buffer,
+            value_buffer,
+            options,
+            [parent, parent_start](ErlNifEnv *env, const uint8_t *, OffsetT offset, size_t nbytes) -> ERL_NIF_TERM {
+                return enif_make_sub_binary(env, parent, offset - parent_start, nbytes);
+            },
+            tail
+        );
+    }
+
+    return interned_strings_from_buffer(
+        env,
+        element_offset,
+        element_count,
+        validity_bitmap,
+        offsets_buffer,
+        value_buffer,
+        options,
+        [](ErlNifEnv *env, const uint8_t * string_buffers, OffsetT offset, size_t nbytes) -> ERL_NIF_TERM {
+            return erlang::nif::make_binary(env, (const char *)(string_buffers + offset), nbytes);
+        },
+        tail
+    );
+}
+
+/// Decodes `element_count` values of a string view or binary view array.
+///
+/// Each view is 16 bytes. Values of up to 12 bytes are stored inline in the
+/// view and are copied from it directly, empty values are returned as nil
+/// like those of string and binary arrays. Longer values live in one of the
+/// variadic data buffers. In zero-copy mode they become sub-binaries of that
+/// buffer, otherwise they are copied.
+///
+/// `values->buffers` holds the validity bitmap, the views, the variadic
+/// data buffers, and finally the sizes of the variadic data buffers.
+///
+/// @return 0 if success, 1 if failed
+static int binary_views_from_buffer(
+    ErlNifEnv *env,
+    struct ArrowArray * values,
+    int64_t element_offset,
+    int64_t element_count,
+    const AdbcMaterializeOptions * options,
+    ERL_NIF_TERM &out,
+    ERL_NIF_TERM &error,
+    ERL_NIF_TERM tail = 0) {
+    constexpr int64_t view_size = 16;
+    constexpr int32_t inline_size = 12;
+    const uint8_t * validity_bitmap = adbc_validity_bitmap(values, element_offset, element_count);
+    const uint8_t * views = (const uint8_t *)values->buffers[1];
+    int64_t n_variadic_buffers = values->n_buffers - 3;
+    const int64_t * variadic_sizes = (const int64_t *)values->buffers[values->n_buffers - 1];
+
+    // the binaries that reference each variadic buffer in zero-copy mode
+    std::vector<ERL_NIF_TERM> parents(n_variadic_buffers, 0);
+    std::vector<ERL_NIF_TERM> terms(element_count);
+    AdbcStringInterner not_interned;
+    not_interned.active = false;
+    AdbcStringInterner &interner = options != nullptr && options->intern_strings ? options->interner : not_interned;
+    bool in_bounds = true;
+    visit_valid_runs(element_offset, element_count, validity_bitmap, terms, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end && in_bounds; i++) {
+            const uint8_t * view = views + i * view_size;
+            int32_t nbytes;
+            memcpy(&nbytes, view, sizeof(nbytes));
+            if (nbytes <= 0) {
+                // empty values are nil, as in `strings_from_buffer`
+                terms[i - element_offset] = kAtomNil;
+                continue;
+            }
+            if (nbytes <= inline_size) {
+                terms[i - element_offset] = interner.intern(view + 4, (size_t)nbytes, [&]() -> ERL_NIF_TERM {
+                    return erlang::nif::make_binary(env, (const char *)(view + 4), (size_t)nbytes);
+                });
+                continue;
+            }
+
+            int32_t buffer_index, buffer_offset;
+            memcpy(&buffer_index, view + 8, sizeof(buffer_index));
+            memcpy(&buffer_offset, view + 12, sizeof(buffer_offset));
+            if (buffer_index < 0 || buffer_index >= n_variadic_buffers || buffer_offset < 0 ||
+                (variadic_sizes != nullptr && (int64_t)buffer_offset + nbytes > variadic_sizes[buffer_index])) {
+                in_bounds = false;
+                break;
+            }
+
+            const uint8_t * data = (const uint8_t *)values->buffers[2 + buffer_index];
+            ERL_NIF_TERM &parent = parents[buffer_index];
+            if (parent == 0 && variadic_sizes != nullptr) {
+                make_zero_copy_binary(env, options, data, (size_t)variadic_sizes[buffer_index], parent);
+            }
+            terms[i - element_offset] = interner.intern(data + buffer_offset, (size_t)nbytes, [&]() -> ERL_NIF_TERM {
+                if (parent != 0) {
+                    return enif_make_sub_binary(env, parent, buffer_offset, nbytes);
+                }
+                return erlang::nif::make_binary(env, (const char *)(data + buffer_offset), nbytes);
+            });
+        }
+    });
+    if (!in_bounds) {
+        error = erlang::nif::error(env, "invalid ArrowArray (binary view), the view is out of the bounds of its data buffer");
+        return 1;
+    }
+
+    out = make_list_with_tail(env, terms, tail);
+    return 0;
+}
+
 template <typename M>
 static ERL_NIF_TERM fixed_size_binary_from_buffer(
     ErlNifEnv *env,
@@ -145,24 +309,16 @@ static ERL_NIF_TERM fixed_size_binary_from_buffer(
     size_t element_bytes,
     const uint8_t * validity_bitmap,
     const uint8_t* value_buffer,
-    const M& value_to_nif) {
+    const M& value_to_nif,
+    ERL_NIF_TERM tail = 0) {
     std::vector<ERL_NIF_TERM> values(element_count);
-    if (validity_bitmap == nullptr) {
-        for (int64_t i = element_offset; i < element_offset + element_count; i++) {
+    visit_valid_runs(element_offset, element_count, validity_bitmap, values, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
             values[i - element_offset] = value_to_nif(env, &value_buffer[element_bytes * i]);
         }
-    } else {
-        for (int64_t i = element_offset; i < element_offset + element_count; i++) {
-            uint8_t vbyte = validity_bitmap[i / 8];
-            if (vbyte & (1 << (i % 8))) {
-                values[i - element_offset] = value_to_nif(env, &value_buffer[element_bytes * i]);
-            } else {
-                values[i - element_offset] = kAtomNil;
-            }
-        }
-    }
+    });
 
-    return enif_make_list_from_array(env, values.data(), (unsigned)values.size());
+    return make_list_with_tail(env, values, tail);
 }
 
 template <typename M> static ERL_NIF_TERM fixed_size_binary_from_buffer(
@@ -175,7 +331,279 @@ template <typename M> static ERL_NIF_TERM fixed_size_binary_from_buffer(
     return fixed_size_binary_from_buffer(env, 0, length, element_bytes, validity_bitmap, value_buffer, value_to_nif);
 }
 
-int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+static ERL_NIF_TERM float_value_to_nif(ErlNifEnv *env, double val) {
+    if (std::isnan(val)) {
+        return kAtomNaN;
+    } else if (std::isinf(val)) {
+        if (val > 0) {
+            return kAtomInfinity;
+        } else {
+            return kAtomNegInfinity;
+        }
+    } else {
+        return enif_make_double(env, val);
+    }
+}
+
+/// Like `values_from_buffer` for half-precision values, the whole range is
+/// converted to single precision in one batch first, see `float16_to_float_batch`
+static ERL_NIF_TERM half_float_values_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * validity_bitmap, const uint16_t * value_buffer, ERL_NIF_TERM tail = 0) {
+    std::vector<float> floats(count);
+    float16_to_float_batch(value_buffer + offset, floats.data(), count);
+
+    std::vector<ERL_NIF_TERM> values(count);
+    visit_valid_runs(offset, count, validity_bitmap, values, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            values[i - offset] = float_value_to_nif(env, floats[i - offset]);
+        }
+    });
+
+    return make_list_with_tail(env, values, tail);
+}
+
+template <typename T> static int decode_signed_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const T *)values->buffers[1], enif_make_int64, tail);
+    return 0;
+}
+
+template <typename T> static int decode_unsigned_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const T *)values->buffers[1], enif_make_uint64, tail);
+    return 0;
+}
+
+template <typename T> static int decode_float_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const T *)values->buffers[1], float_value_to_nif, tail);
+    return 0;
+}
+
+static int decode_half_float_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = half_float_values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const uint16_t *)values->buffers[1], tail);
+    return 0;
+}
+
+static int decode_boolean_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = boolean_values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const bool *)values->buffers[1], tail);
+    return 0;
+}
+
+template <typename OffsetT> static int decode_binary_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions * options, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = binaries_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const OffsetT *)values->buffers[1], (const uint8_t *)values->buffers[2], options, tail);
+    return 0;
+}
+
+static int decode_binary_view_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions * options, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &error) {
+    return binary_views_from_buffer(env, values, offset, count, options, out, error, tail);
+}
+
+/// date32 values are days, date64 values are milliseconds
+template <typename T> static int decode_date_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const T *)values->buffers[1], [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+        return adbc_calendar_date(env, sizeof(T) == sizeof(int32_t) ? val : adbc_floor_div(val, 86400000));
+    }, tail);
+    return 0;
+}
+
+/// Elixir only supports microsecond precision, nanoseconds are truncated
+static constexpr int adbc_calendar_us_precision(char unit) {
+    return unit == 's' ? 0 : (unit == 'm' ? 3 : 6);
+}
+
+template <typename T, char Unit> static int decode_time_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const T *)values->buffers[1], [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+        int64_t seconds, us;
+        adbc_calendar_split(val, Unit, seconds, us);
+        return adbc_calendar_time(env, seconds, us, adbc_calendar_us_precision(Unit));
+    }, tail);
+    return 0;
+}
+
+template <char Unit> static int decode_timestamp_values(ErlNifEnv *env, const AdbcDecoderPlanNode *, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    out = values_from_buffer(env, offset, count, adbc_validity_bitmap(values, offset, count), (const int64_t *)values->buffers[1], [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+        int64_t seconds, us;
+        adbc_calendar_split(val, Unit, seconds, us);
+        return adbc_calendar_naive_datetime(env, seconds, us, adbc_calendar_us_precision(Unit));
+    }, tail);
+    return 0;
+}
+
+static int decode_decimal_values(ErlNifEnv *env, const AdbcDecoderPlanNode * node, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions *, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    int bits = (int)node->byte_width * 8;
+    int scale = node->scale;
+    out = fixed_size_binary_from_buffer(env, offset, count, (size_t)node->byte_width, adbc_validity_bitmap(values, offset, count), (const uint8_t *)values->buffers[1], [bits, scale](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+        return adbc_decimal_to_nif(env, val, bits, scale);
+    }, tail);
+    return 0;
+}
+
+static int decode_fixed_size_binary_values(ErlNifEnv *env, const AdbcDecoderPlanNode * node, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions * options, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &) {
+    size_t nbytes = (size_t)node->byte_width;
+    const uint8_t * validity_bitmap = adbc_validity_bitmap(values, offset, count);
+    const uint8_t * data = (const uint8_t *)values->buffers[1];
+    ERL_NIF_TERM parent;
+    if (count > 0 && data != nullptr && make_zero_copy_binary(env, options, data + offset * nbytes, count * nbytes, parent)) {
+        const uint8_t * parent_data = data + offset * nbytes;
+        out = fixed_size_binary_from_buffer(env, offset, count, nbytes, validity_bitmap, data, [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+            return enif_make_sub_binary(env, parent, val - parent_data, nbytes);
+        }, tail);
+    } else {
+        out = fixed_size_binary_from_buffer(env, offset, count, nbytes, validity_bitmap, data, [nbytes](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+            return erlang::nif::make_binary(env, (const char *)val, nbytes);
+        }, tail);
+    }
+    return 0;
+}
+
+/// Reads the decimal number at `p` and moves `p` past it
+/// @return false if there is no number at `p`
+static bool arrow_format_parse_int(const char *&p, int64_t &out) {
+    if (*p < '0' || *p > '9') return false;
+    out = 0;
+    while (*p >= '0' && *p <= '9') {
+        out = out * 10 + (*p++ - '0');
+        if (out > INT32_MAX) return false;
+    }
+    return true;
+}
+
+/// Sets the leaf decoder of `node` if its format has one,
+/// the type terms are made in `env`, the env of the plan
+static void arrow_decoder_plan_resolve_leaf(ErlNifEnv * env, AdbcDecoderPlanNode &node) {
+    const char * format = node.format.c_str();
+    size_t format_len = node.format.size();
+
+    node.n_buffers = 2;
+    if (format_len == 1) {
+        switch (format[0]) {
+            case 'c': node.decode = decode_signed_values<int8_t>; node.type = kAdbcColumnTypeS8; break;
+            case 's': node.decode = decode_signed_values<int16_t>; node.type = kAdbcColumnTypeS16; break;
+            case 'i': node.decode = decode_signed_values<int32_t>; node.type = kAdbcColumnTypeS32; break;
+            case 'l': node.decode = decode_signed_values<int64_t>; node.type = kAdbcColumnTypeS64; break;
+            case 'C': node.decode = decode_unsigned_values<uint8_t>; node.type = kAdbcColumnTypeU8; break;
+            case 'S': node.decode = decode_unsigned_values<uint16_t>; node.type = kAdbcColumnTypeU16; break;
+            case 'I': node.decode = decode_unsigned_values<uint32_t>; node.type = kAdbcColumnTypeU32; break;
+            case 'L': node.decode = decode_unsigned_values<uint64_t>; node.type = kAdbcColumnTypeU64; break;
+            case 'e': node.decode = decode_half_float_values; node.type = kAdbcColumnTypeF16; break;
+            case 'f': node.decode = decode_float_values<float>; node.type = kAdbcColumnTypeF32; break;
+            case 'g': node.decode = decode_float_values<double>; node.type = kAdbcColumnTypeF64; break;
+            case 'b': node.decode = decode_boolean_values; node.type = kAdbcColumnTypeBool; break;
+            case 'u': node.decode = decode_binary_values<int32_t>; node.type = kAdbcColumnTypeString; node.n_buffers = 3; break;
+            case 'z': node.decode = decode_binary_values<int32_t>; node.type = kAdbcColumnTypeBinary; node.n_buffers = 3; break;
+            case 'U': node.decode = decode_binary_values<int64_t>; node.type = kAdbcColumnTypeLargeString; node.n_buffers = 3; break;
+            case 'Z': node.decode = decode_binary_values<int64_t>; node.type = kAdbcColumnTypeLargeBinary; node.n_buffers = 3; break;
+            default: break;
+        }
+    } else if (node.format == "vu" || node.format == "vz") {
+        node.decode = decode_binary_view_values;
+        node.type = format[1] == 'u' ? kAdbcColumnTypeStringView : kAdbcColumnTypeBinaryView;
+        node.n_buffers = 3;
+        node.variadic_buffers = true;
+    } else if (format_len == 3 && format[0] == 't') {
+        switch (format[1] * 256 + format[2]) {
+            case 'd' * 256 + 'D': node.decode = decode_date_values<int32_t>; node.type = kAdbcColumnTypeDate32; break;
+            case 'd' * 256 + 'm': node.decode = decode_date_values<int64_t>; node.type = kAdbcColumnTypeDate64; break;
+            case 't' * 256 + 's': node.decode = decode_time_values<int32_t, 's'>; node.type = kAdbcColumnTypeTime32Seconds; break;
+            case 't' * 256 + 'm': node.decode = decode_time_values<int32_t, 'm'>; node.type = kAdbcColumnTypeTime32Milliseconds; break;
+            case 't' * 256 + 'u': node.decode = decode_time_values<int64_t, 'u'>; node.type = kAdbcColumnTypeTime64Microseconds; break;
+            case 't' * 256 + 'n': node.decode = decode_time_values<int64_t, 'n'>; node.type = kAdbcColumnTypeTime64Nanoseconds; break;
+            case 'D' * 256 + 's': node.decode = decode_signed_values<int64_t>; node.type = kAdbcColumnTypeDurationSeconds; break;
+            case 'D' * 256 + 'm': node.decode = decode_signed_values<int64_t>; node.type = kAdbcColumnTypeDurationMilliseconds; break;
+            case 'D' * 256 + 'u': node.decode = decode_signed_values<int64_t>; node.type = kAdbcColumnTypeDurationMicroseconds; break;
+            case 'D' * 256 + 'n': node.decode = decode_signed_values<int64_t>; node.type = kAdbcColumnTypeDurationNanoseconds; break;
+            default: break;
+        }
+    } else if (format_len >= 4 && format[0] == 't' && format[1] == 's' && format[3] == ':') {
+        ERL_NIF_TERM unit = 0;
+        switch (format[2]) {
+            case 's': node.decode = decode_timestamp_values<'s'>; unit = kAtomSeconds; break;
+            case 'm': node.decode = decode_timestamp_values<'m'>; unit = kAtomMilliseconds; break;
+            case 'u': node.decode = decode_timestamp_values<'u'>; unit = kAtomMicroseconds; break;
+            case 'n': node.decode = decode_timestamp_values<'n'>; unit = kAtomNanoseconds; break;
+            default: break;
+        }
+        if (node.decode) {
+            ERL_NIF_TERM timezone = format_len > 4 ? erlang::nif::make_binary(env, format + 4) : kAtomNil;
+            node.type = enif_make_tuple3(env, kAtomTimestamp, unit, timezone);
+        }
+    } else if (format_len > 2 && format[0] == 'w' && format[1] == ':') {
+        // w:N
+        const char * p = format + 2;
+        int64_t nbytes = 0;
+        if (arrow_format_parse_int(p, nbytes) && *p == '\0' && nbytes > 0) {
+            node.decode = decode_fixed_size_binary_values;
+            node.type = kAdbcColumnTypeFixedSizeBinary(nbytes);
+            node.byte_width = nbytes;
+        }
+    } else if (format_len > 2 && format[0] == 'd' && format[1] == ':') {
+        // d:P,S[,N]
+        const char * p = format + 2;
+        int64_t precision = 0, scale = 0, bits = 128;
+        bool valid = arrow_format_parse_int(p, precision) && *p++ == ',' && arrow_format_parse_int(p, scale);
+        if (valid && *p == ',') {
+            p++;
+            valid = arrow_format_parse_int(p, bits);
+        }
+        if (valid && *p == '\0' && (bits == 32 || bits == 64 || bits == 128 || bits == 256)) {
+            node.decode = decode_decimal_values;
+            node.type = kAdbcColumnTypeDecimal((int)bits, (int)precision, (int)scale);
+            node.byte_width = bits / 8;
+            node.scale = (int)scale;
+        }
+    }
+
+    if (node.decode == nullptr) {
+        node.n_buffers = 0;
+    }
+}
+
+/// Builds the decoder plan node for `schema` and all its descendants
+/// @return 0 if success, 1 if failed
+static int arrow_decoder_plan_build(ErlNifEnv * plan_env, const struct ArrowSchema * schema, AdbcDecoderPlanNode &node) {
+    if (schema == nullptr) return 1;
+    if (schema->n_children > 0 && schema->children == nullptr) return 1;
+
+    node.format = schema->format ? schema->format : "";
+    node.name = erlang::nif::make_binary(plan_env, schema->name ? schema->name : "");
+    if (arrow_metadata_to_nif_term(plan_env, schema->metadata, &node.metadata) != NANOARROW_OK) {
+        return 1;
+    }
+    arrow_decoder_plan_resolve_leaf(plan_env, node);
+
+    node.children.resize(schema->n_children);
+    for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+        if (arrow_decoder_plan_build(plan_env, schema->children[child_i], node.children[child_i]) != 0) {
+            return 1;
+        }
+    }
+    if (schema->dictionary != nullptr) {
+        node.dictionary.reset(new AdbcDecoderPlanNode());
+        if (arrow_decoder_plan_build(plan_env, schema->dictionary, *node.dictionary) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// Builds the decoder plan nodes for `plan.schema`
+///
+/// `plan.root` is left as nullptr if failed.
+/// @return 0 if success, 1 if failed
+static int arrow_decoder_plan_init(AdbcDecoderPlan &plan) {
+    if (plan.env == nullptr) {
+        plan.env = enif_alloc_env();
+        if (plan.env == nullptr) {
+            return 1;
+        }
+    }
+    plan.root = new AdbcDecoderPlanNode();
+    if (arrow_decoder_plan_build(plan.env, &plan.schema, *plan.root) != 0) {
+        delete plan.root;
+        plan.root = nullptr;
+        return 1;
+    }
+    return 0;
+}
+
+int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr, however, schema->n_children > 0");
         return 1;
@@ -189,36 +617,38 @@ int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema
         return 1;
     }
 
-    constexpr int64_t bitmap_buffer_index = 0;
-    const uint8_t * bitmap_buffer = (const uint8_t *)values->buffers[bitmap_buffer_index];
+    const uint8_t * validity_bitmap = nullptr;
+    if ((schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0)) {
+        validity_bitmap = adbc_validity_bitmap(values, 0, values->n_children);
+    }
     children.resize(values->n_children);
-    for (int64_t child_i = 0; child_i < values->n_children; child_i++) {
-        if (bitmap_buffer && ((schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0))) {
-            uint8_t vbyte = bitmap_buffer[child_i / 8];
-            if (!(vbyte & (1 << (child_i % 8)))) {
-                children[child_i] = kAtomNil;
-                continue;
+    int has_error = 0;
+    visit_valid_runs(0, values->n_children, validity_bitmap, children, [&](int64_t begin, int64_t end) {
+        for (int64_t child_i = begin; child_i < end && !has_error; child_i++) {
+            struct ArrowSchema * child_schema = schema->children[child_i];
+            struct ArrowArray * child_values = values->children[child_i];
+            std::vector<ERL_NIF_TERM> childrens;
+            ERL_NIF_TERM child_type;
+            ERL_NIF_TERM child_metadata;
+            if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error, false, options, arrow_decoder_plan_child(plan_node, child_i)) == 1) {
+                has_error = 1;
+                return;
             }
-        }
-        struct ArrowSchema * child_schema = schema->children[child_i];
-        struct ArrowArray * child_values = values->children[child_i];
-        std::vector<ERL_NIF_TERM> childrens;
-        ERL_NIF_TERM child_type;
-        ERL_NIF_TERM child_metadata;
-        if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error) == 1) {
-            return 1;
-        }
 
-        if (childrens.size() == 1) {
-            children[child_i] = childrens[0];
-        } else {
-            bool nullable = (child_schema->flags & ARROW_FLAG_NULLABLE) || (child_values->null_count > 0);
-            if (enif_is_identical(childrens[1], kAtomNil)) {
-                children[child_i] = kAtomNil;
+            if (childrens.size() == 1) {
+                children[child_i] = childrens[0];
             } else {
-                children[child_i] = make_adbc_column(env, schema, values, childrens[0], child_type, nullable, child_metadata, childrens[1]);
+                bool nullable = (child_schema->flags & ARROW_FLAG_NULLABLE) || (child_values->null_count > 0);
+                if (enif_is_identical(childrens[1], kAtomNil)) {
+                    children[child_i] = kAtomNil;
+                } else {
+                    children[child_i] = make_adbc_column(env, schema, values, childrens[0], child_type, nullable, child_metadata, childrens[1]);
+                }
             }
         }
+    });
+    if (has_error) {
+        return 1;
     }
     return 0;
 }
@@ -227,7 +657,7 @@ int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema
     return get_arrow_array_children_as_list(env, schema, values, 0, -1, level, children, error);
 }
 
-int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr while schema->n_children > 0");
         return 1;
@@ -248,7 +678,7 @@ int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowAr
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error) == 1) {
+        if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error, false, options, arrow_decoder_plan_child(plan_node, child_i)) == 1) {
             return 1;
         }
 
@@ -273,14 +703,14 @@ int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowAr
 int get_arrow_dictionary(ErlNifEnv *env,
     struct ArrowSchema * index_schema, struct ArrowArray * index_array,
     struct ArrowSchema * value_schema, struct ArrowArray * value_array,
-    int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+    int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr) {
     std::vector<ERL_NIF_TERM> keys, values;
     ERL_NIF_TERM index_type, index_metadata;
     ERL_NIF_TERM value_type, value_metadata;
-    if (arrow_array_to_nif_term(env, index_schema, index_array, offset, count, level + 1, keys, index_type, index_metadata, error, true) == 1) {
+    if (arrow_array_to_nif_term(env, index_schema, index_array, offset, count, level + 1, keys, index_type, index_metadata, error, true, options, plan_node) == 1) {
         return 1;
     }
-    if (arrow_array_to_nif_term(env, value_schema, value_array, offset, count, level + 1, values, value_type, value_metadata, error, false) == 1) {
+    if (arrow_array_to_nif_term(env, value_schema, value_array, offset, count, level + 1, values, value_type, value_metadata, error, false, options, arrow_decoder_plan_dictionary(plan_node)) == 1) {
         return 1;
     }
 
@@ -307,58 +737,239 @@ int get_arrow_dictionary(ErlNifEnv *env,
     return get_arrow_dictionary(env, index_schema, index_array, value_schema, value_array, 0, -1, level, children, error);
 }
 
-ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+/// @return true if `schema` is decoded into a list with one term per value
+/// under `options`, so that the terms can be picked out of it by index.
+///
+/// Leaf types always are, and dictionary, list view and run-end encoded types
+/// are when `options` expand them and their values are expandable too.
+static bool arrow_array_is_expandable(const struct ArrowSchema * schema, const AdbcMaterializeOptions * options) {
+    if (schema == nullptr) return false;
+    if (schema->dictionary != nullptr) {
+        return options != nullptr && options->expand_dictionary && arrow_array_is_expandable(schema->dictionary, options);
+    }
+    if (schema->n_children == 0) return true;
+    if (options == nullptr || schema->children == nullptr || schema->format == nullptr) return false;
+
+    if (strcmp("+m", schema->format) == 0) {
+        if (!options->maps || schema->n_children != 1 || schema->children[0]->n_children != 2 || schema->children[0]->children == nullptr) {
+            return false;
+        }
+        struct ArrowSchema * entries_schema = schema->children[0];
+        return arrow_array_is_expandable(entries_schema->children[0], options) && arrow_array_is_expandable(entries_schema->children[1], options);
+    }
+    if (!options->expand) return false;
+
+    if (strcmp("+vl", schema->format) == 0 || strcmp("+vL", schema->format) == 0) {
+        return schema->n_children == 1 && arrow_array_is_expandable(schema->children[0], options);
+    }
+    if (strcmp("+r", schema->format) == 0) {
+        return schema->n_children == 2 && arrow_array_is_expandable(schema->children[1], options);
+    }
+    return false;
+}
+
+/// Decodes `count` values of `values`, starting at `offset`, into `out`,
+/// one term per value.
+///
+/// `schema` must be expandable under `options`.
+/// @return 0 if success, 1 if failed
+static int arrow_array_to_expanded_terms(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &out, ERL_NIF_TERM &value_type, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    std::vector<ERL_NIF_TERM> value_terms;
+    ERL_NIF_TERM value_metadata;
+    if (arrow_array_to_nif_term(env, schema, values, offset, count, level + 1, value_terms, value_type, value_metadata, error, false, options, plan_node) == 1) {
+        return 1;
+    }
+
+    ERL_NIF_TERM list = value_terms.size() == 1 ? value_terms[0] : value_terms[1];
+    unsigned length = 0;
+    if (!enif_get_list_length(env, list, &length)) {
+        error = erlang::nif::error(env, "invalid ArrowArray, cannot expand its values");
+        return 1;
+    }
+    out.clear();
+    out.reserve(length);
+    ERL_NIF_TERM head, tail;
+    while (enif_get_list_cell(env, list, &head, &tail)) {
+        out.emplace_back(head);
+        list = tail;
+    }
+    return 0;
+}
+
+/// Decodes all values of `values` into `out`, one term per value.
+///
+/// `schema` must be expandable under `options`.
+/// @return 0 if success, 1 if failed
+static int arrow_array_to_expanded_terms(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out, ERL_NIF_TERM &value_type, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    return arrow_array_to_expanded_terms(env, schema, values, 0, -1, level, out, value_type, error, options, plan_node);
+}
+
+template <typename IndexT> static int expand_dictionary_indices(
+    ErlNifEnv *env,
+    struct ArrowArray * index_array,
+    int64_t offset,
+    int64_t count,
+    const std::vector<ERL_NIF_TERM> &dictionary,
+    std::vector<ERL_NIF_TERM> &out,
+    ERL_NIF_TERM &error) {
+    const uint8_t * validity_bitmap = adbc_validity_bitmap(index_array, offset, count);
+    const IndexT * indices = (const IndexT *)index_array->buffers[1];
+    out.resize(count);
+    bool in_range = true;
+    visit_valid_runs(offset, count, validity_bitmap, out, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end && in_range; i++) {
+            int64_t index = (int64_t)indices[i];
+            if (index < 0 || (uint64_t)index >= dictionary.size()) {
+                in_range = false;
+            } else {
+                out[i - offset] = dictionary[index];
+            }
+        }
+    });
+    if (!in_range) {
+        error = erlang::nif::error(env, "invalid ArrowArray (dictionary), index out of range");
+        return 1;
+    }
+    return 0;
+}
+
+/// Decodes `count` rows of a dictionary-encoded array, starting at `offset`,
+/// into a list of the values their indices point at.
+///
+/// Every value of the dictionary is decoded once per materialization, see
+/// `AdbcMaterializeOptions::dictionaries`, and the rows with the same index
+/// share its term, so a column with few distinct strings holds one binary
+/// per distinct string.
+///
+/// @return 0 if success, 1 if failed
+static int get_arrow_dictionary_expanded(ErlNifEnv *env,
+    struct ArrowSchema * index_schema, struct ArrowArray * index_array,
+    struct ArrowSchema * value_schema, struct ArrowArray * value_array,
+    int64_t offset, int64_t count, uint64_t level, ERL_NIF_TERM &out, ERL_NIF_TERM &value_type, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    const char * index_format = index_schema->format ? index_schema->format : "";
+    if (strlen(index_format) != 1) {
+        error = erlang::nif::error(env, "invalid ArrowSchema (dictionary), the index type must be an integer");
+        return 1;
+    }
+    if (index_array->n_buffers != 2) {
+        error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (dictionary), values->n_buffers != 2");
+        return 1;
+    }
+
+    auto cached = options->dictionaries.find(value_array);
+    if (cached == options->dictionaries.end()) {
+        AdbcMaterializeOptions::ExpandedDictionary decoded;
+        if (arrow_array_to_expanded_terms(env, value_schema, value_array, level, decoded.values, decoded.type, error, options, arrow_decoder_plan_dictionary(plan_node)) == 1) {
+            return 1;
+        }
+        cached = options->dictionaries.emplace(value_array, std::move(decoded)).first;
+    }
+    const std::vector<ERL_NIF_TERM> &dictionary = cached->second.values;
+    value_type = cached->second.type;
+
+    if (count == -1) count = index_array->length;
+    if (count > index_array->length) count = index_array->length - offset;
+
+    std::vector<ERL_NIF_TERM> rows;
+    int ret;
+    switch (index_format[0]) {
+        case 'c': ret = expand_dictionary_indices<int8_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'C': ret = expand_dictionary_indices<uint8_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 's': ret = expand_dictionary_indices<int16_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'S': ret = expand_dictionary_indices<uint16_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'i': ret = expand_dictionary_indices<int32_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'I': ret = expand_dictionary_indices<uint32_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'l': ret = expand_dictionary_indices<int64_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        case 'L': ret = expand_dictionary_indices<uint64_t>(env, index_array, offset, count, dictionary, rows, error); break;
+        default:
+            error = erlang::nif::error(env, "invalid ArrowSchema (dictionary), the index type must be an integer");
+            return 1;
+    }
+    if (ret != 0) {
+        return 1;
+    }
+
+    out = enif_make_list_from_array(env, rows.data(), (unsigned)rows.size());
+    return 0;
+}
+
+/// Finds the key and value children of a map array
+/// @return 0 if success, 1 if failed
+static int get_arrow_map_entries(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values,
+    struct ArrowSchema *&key_schema, struct ArrowArray *&key_values,
+    struct ArrowSchema *&value_schema, struct ArrowArray *&value_values, ERL_NIF_TERM &error,
+    const AdbcDecoderPlanNode * plan_node, const AdbcDecoderPlanNode *&key_node, const AdbcDecoderPlanNode *&value_node) {
     // From https://arrow.apache.org/docs/format/CDataInterface.html#data-type-description-format-strings
     //
     //   As specified in the Arrow columnar format, the map type has a single child type named entries,
     //   itself a 2-child struct type of (key, value).
 
-    ERL_NIF_TERM error{}, map_out{};
     if (schema->children == nullptr) {
-        return erlang::nif::error(env, "invalid ArrowSchema (map), schema->children == nullptr");
+        error = erlang::nif::error(env, "invalid ArrowSchema (map), schema->children == nullptr");
+        return 1;
     }
     if (schema->n_children != 1) {
-        return erlang::nif::error(env, "invalid ArrowSchema (map), schema->n_children != 1");
+        error = erlang::nif::error(env, "invalid ArrowSchema (map), schema->n_children != 1");
+        return 1;
     }
     if (values->children == nullptr) {
-        return erlang::nif::error(env, "invalid ArrowArray (map), values->children == nullptr");
+        error = erlang::nif::error(env, "invalid ArrowArray (map), values->children == nullptr");
+        return 1;
     }
     if (values->n_children != 1) {
-        return erlang::nif::error(env, "invalid ArrowArray (map), values->n_children != 1");
+        error = erlang::nif::error(env, "invalid ArrowArray (map), values->n_children != 1");
+        return 1;
     }
 
     struct ArrowSchema * entries_schema = schema->children[0];
     struct ArrowArray * entries_values = values->children[0];
+    const AdbcDecoderPlanNode * entries_node = arrow_decoder_plan_child(plan_node, 0);
     if (strcmp("entries", entries_schema->name) != 0) {
-        return erlang::nif::error(env, "invalid ArrowSchema (map), its single child is not named entries");
+        error = erlang::nif::error(env, "invalid ArrowSchema (map), its single child is not named entries");
+        return 1;
     }
     if (entries_schema->n_children != 2) {
-        return erlang::nif::error(env, "invalid ArrowSchema (map), its entries n_children != 2");
+        error = erlang::nif::error(env, "invalid ArrowSchema (map), its entries n_children != 2");
+        return 1;
     }
 
-    struct ArrowSchema * key_schema, * value_schema;
-    struct ArrowArray * key_values, * value_values;
     if (strcmp("key", entries_schema->children[0]->name) == 0 && strcmp("value", entries_schema->children[1]->name) == 0) {
         key_schema = entries_schema->children[0];
         key_values = entries_values->children[0];
         value_schema = entries_schema->children[1];
         value_values = entries_values->children[1];
+        key_node = arrow_decoder_plan_child(entries_node, 0);
+        value_node = arrow_decoder_plan_child(entries_node, 1);
     } else if (strcmp("key", entries_schema->children[1]->name) == 0 && strcmp("value", entries_schema->children[0]->name) == 0) {
         key_schema = entries_schema->children[1];
         key_values = entries_values->children[1];
         value_schema = entries_schema->children[0];
         value_values = entries_values->children[0];
+        key_node = arrow_decoder_plan_child(entries_node, 1);
+        value_node = arrow_decoder_plan_child(entries_node, 0);
     } else {
-        return erlang::nif::error(env, "invalid map entries, key or value or both are missing");
+        error = erlang::nif::error(env, "invalid map entries, key or value or both are missing");
+        return 1;
+    }
+    return 0;
+}
+
+ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    ERL_NIF_TERM error{}, map_out{};
+    struct ArrowSchema * key_schema, * value_schema;
+    struct ArrowArray * key_values, * value_values;
+    const AdbcDecoderPlanNode * key_node = nullptr, * value_node = nullptr;
+    if (get_arrow_map_entries(env, schema, values, key_schema, key_values, value_schema, value_values, error, plan_node, key_node, value_node) == 1) {
+        return error;
     }
 
     std::vector<ERL_NIF_TERM> nif_keys, nif_values;
     ERL_NIF_TERM key_type, key_metadata;
     ERL_NIF_TERM value_type, value_metadata;
-    if (arrow_array_to_nif_term(env, key_schema, key_values, offset, count, level + 1, nif_keys, key_type, key_metadata, error) == 1) {
+    if (arrow_array_to_nif_term(env, key_schema, key_values, offset, count, level + 1, nif_keys, key_type, key_metadata, error, false, options, key_node) == 1) {
         return erlang::nif::error(env, "failed to get map keys");
     }
-    if (arrow_array_to_nif_term(env, value_schema, value_values, offset, count, level + 1, nif_values, value_type, value_metadata, error) == 1) {
+    if (arrow_array_to_nif_term(env, value_schema, value_values, offset, count, level + 1, nif_values, value_type, value_metadata, error, false, options, value_node) == 1) {
         return erlang::nif::error(env, "failed to get map values");
     }
 
@@ -379,7 +990,99 @@ ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * s
     return get_arrow_array_map_children(env, schema, values, 0, -1, level);
 }
 
-ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+/// Makes one row of a map column from its `count` entries,
+/// handling duplicate keys as asked by `options`
+/// @return 0 if success, 1 if failed
+static int make_arrow_map_row(ErlNifEnv *env, ERL_NIF_TERM * keys, ERL_NIF_TERM * values, int64_t count, const AdbcMaterializeOptions * options, ERL_NIF_TERM &out, ERL_NIF_TERM &error) {
+    if (enif_make_map_from_arrays(env, keys, values, (size_t)count, &out)) {
+        return 0;
+    }
+
+    // it only fails when a key appears more than once
+    if (options->duplicate_keys == AdbcMaterializeOptions::kDuplicateKeysError) {
+        error = erlang::nif::error(env, "invalid map row, a key appears more than once, pass duplicate_keys: :first or :last to keep one of its values");
+        return 1;
+    }
+    out = enif_make_new_map(env);
+    if (options->duplicate_keys == AdbcMaterializeOptions::kDuplicateKeysLast) {
+        for (int64_t i = 0; i < count; i++) {
+            enif_make_map_put(env, out, keys[i], values[i], &out);
+        }
+    } else {
+        for (int64_t i = count - 1; i >= 0; i--) {
+            enif_make_map_put(env, out, keys[i], values[i], &out);
+        }
+    }
+    return 0;
+}
+
+/// Decodes `count` rows of a map array, starting at `offset`, into a list
+/// with an Elixir map for each row, or `nil` for null rows.
+///
+/// Only the entries of these rows are decoded, and each row is built
+/// from its slice of them with `enif_make_map_from_arrays`.
+///
+/// @return 0 if success, 1 if failed
+static int get_arrow_array_map_expanded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ERL_NIF_TERM &out, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    struct ArrowSchema * key_schema, * value_schema;
+    struct ArrowArray * key_values, * value_values;
+    const AdbcDecoderPlanNode * key_node = nullptr, * value_node = nullptr;
+    if (get_arrow_map_entries(env, schema, values, key_schema, key_values, value_schema, value_values, error, plan_node, key_node, value_node) == 1) {
+        return 1;
+    }
+    if (values->n_buffers != 2 || values->buffers[1] == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowArray (map), offsets == nullptr");
+        return 1;
+    }
+
+    if (count == -1) count = values->length;
+    if (count > values->length) count = values->length - offset;
+
+    const int32_t * offsets = (const int32_t *)values->buffers[1];
+    int64_t entries_start = offsets[offset];
+    int64_t entries_count = offsets[offset + count] - entries_start;
+    if (entries_start < 0 || entries_count < 0 || entries_start + entries_count > key_values->length || entries_start + entries_count > value_values->length) {
+        error = erlang::nif::error(env, "invalid ArrowArray (map), offsets out of range");
+        return 1;
+    }
+
+    std::vector<ERL_NIF_TERM> keys, items;
+    ERL_NIF_TERM key_type, value_type;
+    if (arrow_array_to_expanded_terms(env, key_schema, key_values, entries_start, entries_count, level, keys, key_type, error, options, key_node) == 1) {
+        return 1;
+    }
+    if (arrow_array_to_expanded_terms(env, value_schema, value_values, entries_start, entries_count, level, items, value_type, error, options, value_node) == 1) {
+        return 1;
+    }
+    if ((int64_t)keys.size() != entries_count || (int64_t)items.size() != entries_count) {
+        error = erlang::nif::error(env, "invalid ArrowArray (map), keys and values do not match its entries");
+        return 1;
+    }
+
+    const uint8_t * validity_bitmap = adbc_validity_bitmap(values, offset, count);
+    std::vector<ERL_NIF_TERM> rows(count);
+    int has_error = 0;
+    visit_valid_runs(offset, count, validity_bitmap, rows, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end && !has_error; i++) {
+            int64_t start = offsets[i] - entries_start;
+            int64_t size = offsets[i + 1] - offsets[i];
+            if (start < 0 || size < 0 || start + size > entries_count) {
+                error = erlang::nif::error(env, "invalid ArrowArray (map), offsets out of range");
+                has_error = 1;
+            } else if (make_arrow_map_row(env, keys.data() + start, items.data() + start, size, options, rows[i - offset], error) == 1) {
+                has_error = 1;
+            }
+        }
+    });
+    if (has_error) {
+        return 1;
+    }
+
+    out = enif_make_list_from_array(env, rows.data(), (unsigned)rows.size());
+    return 0;
+}
+
+ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     ERL_NIF_TERM error{};
     if (schema->n_children > 0 && schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (dense union), schema->children == nullptr while schema->n_children > 0 ");
@@ -419,7 +1122,7 @@ ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSc
 
         ERL_NIF_TERM field_type;
         ERL_NIF_TERM field_metadata;
-        if (arrow_array_to_nif_term(env, field_schema, field_array, child_offset, 1, level + 1, field_values, field_type, field_metadata, error) == 1) {
+        if (arrow_array_to_nif_term(env, field_schema, field_array, child_offset, 1, level + 1, field_values, field_type, field_metadata, error, false, options, arrow_decoder_plan_child(plan_node, child_type)) == 1) {
             return error;
         }
 
@@ -445,7 +1148,7 @@ ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSc
     return get_arrow_array_dense_union_children(env, schema, values, 0, -1, level);
 }
 
-ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     ERL_NIF_TERM error{};
     if (schema->n_children > 0 && schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (sparse union), schema->children == nullptr while schema->n_children > 0 ");
@@ -483,7 +1186,7 @@ ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowS
         ERL_NIF_TERM field_type;
         // todo: use field_metadata
         ERL_NIF_TERM field_metadata;
-        if (arrow_array_to_nif_term(env, field_schema, field_array, child_i, 1, level + 1, field_values, field_type, field_metadata, error) == 1) {
+        if (arrow_array_to_nif_term(env, field_schema, field_array, child_i, 1, level + 1, field_values, field_type, field_metadata, error, false, options, arrow_decoder_plan_child(plan_node, child_type)) == 1) {
             return error;
         }
 
@@ -509,7 +1212,7 @@ ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowS
     return get_arrow_array_sparse_union_children(env, schema, values, 0, -1, level);
 }
 
-ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr) {
     ERL_NIF_TERM error{};
     if (schema->n_children != 2 || values->n_children != 2) {
         return erlang::nif::error(env, "invalid ArrowSchema (run_end_encoded), schema->n_children != 2 || values->n_children != 2");
@@ -529,7 +1232,7 @@ ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * sche
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_array_to_nif_term(env, schema->children[child_i], values->children[child_i], 0, -1, level + 1, childrens, child_type, child_metadata, error) == 1) {
+        if (arrow_array_to_nif_term(env, schema->children[child_i], values->children[child_i], 0, -1, level + 1, childrens, child_type, child_metadata, error, false, options, arrow_decoder_plan_child(plan_node, child_i)) == 1) {
             return 1;
         }
 
@@ -558,7 +1261,108 @@ ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * sche
     return get_arrow_run_end_encoded(env, schema, values, 0, -1, level);
 }
 
-ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items) {
+template <typename RunEndT> static int expand_run_ends(
+    ErlNifEnv *env,
+    struct ArrowSchema * schema,
+    struct ArrowArray * values,
+    int64_t logical_offset,
+    int64_t count,
+    uint64_t level,
+    std::vector<ERL_NIF_TERM> &out,
+    ERL_NIF_TERM &value_type,
+    ERL_NIF_TERM &error,
+    const AdbcMaterializeOptions * options,
+    const AdbcDecoderPlanNode * plan_node) {
+    struct ArrowArray * run_ends_array = values->children[0];
+    struct ArrowArray * run_values_array = values->children[1];
+    const RunEndT * run_ends = (const RunEndT *)run_ends_array->buffers[1];
+    int64_t n_runs = run_ends_array->length;
+    if (run_values_array->length < n_runs) {
+        n_runs = run_values_array->length;
+    }
+
+    // the runs that cover the rows, `[first_run, last_run)`, the first one
+    // is the first run that ends after `logical_offset`
+    int64_t first_run = std::upper_bound(run_ends, run_ends + n_runs, (RunEndT)logical_offset) - run_ends;
+    int64_t last_run = first_run;
+    if (count > 0) {
+        last_run = std::upper_bound(run_ends + first_run, run_ends + n_runs, (RunEndT)(logical_offset + count - 1)) - run_ends;
+        last_run = last_run < n_runs ? last_run + 1 : n_runs;
+    }
+
+    std::vector<ERL_NIF_TERM> run_values;
+    if (arrow_array_to_expanded_terms(env, schema->children[1], run_values_array, first_run, last_run - first_run, level, run_values, value_type, error, options, arrow_decoder_plan_child(plan_node, 1)) == 1) {
+        return 1;
+    }
+
+    out.resize(count);
+    int64_t row = 0;
+    int64_t run = first_run;
+    while (row < count) {
+        if (run >= last_run || run - first_run >= (int64_t)run_values.size()) {
+            error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), the last run ends before the end of the array");
+            return 1;
+        }
+        int64_t run_end = (int64_t)run_ends[run] - logical_offset;
+        if (run_end > count) run_end = count;
+        for (; row < run_end; row++) {
+            out[row] = run_values[run - first_run];
+        }
+        run++;
+    }
+    return 0;
+}
+
+/// Decodes `count` rows of a run-end encoded array, starting at `offset`,
+/// into a list of their values.
+///
+/// The runs that cover these rows are found with a binary search over the
+/// run ends, and only their values are decoded, once per run.
+///
+/// @return 0 if success, 1 if failed
+static int get_arrow_run_end_encoded_expanded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ERL_NIF_TERM &out, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    if (schema->n_children != 2 || values->n_children != 2) {
+        error = erlang::nif::error(env, "invalid ArrowSchema (run_end_encoded), schema->n_children != 2 || values->n_children != 2");
+        return 1;
+    }
+    if (schema->children == nullptr || values->children == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), schema->children == nullptr || values->children == nullptr");
+        return 1;
+    }
+    struct ArrowArray * run_ends_array = values->children[0];
+    const char * run_ends_format = schema->children[0]->format ? schema->children[0]->format : "";
+    if (run_ends_array->n_buffers != 2 || run_ends_array->buffers[1] == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), run_ends has no data buffer");
+        return 1;
+    }
+
+    if (count == -1) count = values->length;
+    if (count > values->length) count = values->length - offset;
+
+    // run ends are logical indices, and they include the offset of the array
+    int64_t logical_offset = values->offset + offset;
+    std::vector<ERL_NIF_TERM> rows;
+    ERL_NIF_TERM value_type;
+    int ret;
+    if (strcmp("s", run_ends_format) == 0) {
+        ret = expand_run_ends<int16_t>(env, schema, values, logical_offset, count, level, rows, value_type, error, options, plan_node);
+    } else if (strcmp("i", run_ends_format) == 0) {
+        ret = expand_run_ends<int32_t>(env, schema, values, logical_offset, count, level, rows, value_type, error, options, plan_node);
+    } else if (strcmp("l", run_ends_format) == 0) {
+        ret = expand_run_ends<int64_t>(env, schema, values, logical_offset, count, level, rows, value_type, error, options, plan_node);
+    } else {
+        error = erlang::nif::error(env, "invalid ArrowSchema (run_end_encoded), run_ends must be int16, int32 or int64");
+        return 1;
+    }
+    if (ret != 0) {
+        return 1;
+    }
+
+    out = enif_make_list_from_array(env, rows.data(), (unsigned)rows.size());
+    return 0;
+}
+
+ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     ERL_NIF_TERM error{};
     if (schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (list), schema->children == nullptr");
@@ -576,13 +1380,12 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
         return erlang::nif::error(env, "invalid ArrowArray (list), internal error: unexpected list type");
     }
 
-    constexpr int64_t bitmap_buffer_index = 0;
-    const uint8_t * bitmap_buffer = (const uint8_t *)values->buffers[bitmap_buffer_index];
     struct ArrowSchema * items_schema = schema->children[0];
     struct ArrowArray * items_values = values->children[0];
     if (!(strcmp("item", items_schema->name) == 0 || strcmp("l", items_schema->name) == 0)) {
         return erlang::nif::error(env, "invalid ArrowSchema (list), its single child is not named `item` or `l`");
     }
+    const AdbcDecoderPlanNode * items_node = arrow_decoder_plan_child(plan_node, 0);
 
     std::vector<ERL_NIF_TERM> children;
     if (list_type == NANOARROW_TYPE_LIST || list_type == NANOARROW_TYPE_LARGE_LIST) {
@@ -592,40 +1395,36 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
         if (count == -1) count = values->length;
         if (count > values->length) count = values->length - offset;
         bool items_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
+        const uint8_t * validity_bitmap = items_nullable ? adbc_validity_bitmap(values, offset, count) : nullptr;
 
         int has_error = 0;
         // Use "item" as the canonical name for list elements
         ERL_NIF_TERM item_name_term = erlang::nif::make_binary(env, "item");
+        children.resize(count);
         auto get_list_children_with_offsets = [&](auto offsets) -> void {
-            for (int64_t i = offset; i < offset + count; i++) {
-                if (bitmap_buffer && items_nullable) {
-                    uint8_t vbyte = bitmap_buffer[i / 8];
-                    if (!(vbyte & (1 << (i % 8)))) {
-                        children.emplace_back(kAtomNil);
-                        continue;
+            visit_valid_runs(offset, count, validity_bitmap, children, [&](int64_t begin, int64_t end) {
+                for (int64_t i = begin; i < end && !has_error; i++) {
+                    std::vector<ERL_NIF_TERM> childrens;
+                    ERL_NIF_TERM children_type;
+                    ERL_NIF_TERM children_metadata;
+                    if (arrow_array_to_nif_term(env, items_schema, items_values, offsets[i], offsets[i+1] - offsets[i], level + 1, childrens, children_type, children_metadata, error, false, options, items_node) == 1) {
+                        has_error = 1;
+                        return;
                     }
-                }
-
-                std::vector<ERL_NIF_TERM> childrens;
-                ERL_NIF_TERM children_type;
-                ERL_NIF_TERM children_metadata;
-                if (arrow_array_to_nif_term(env, items_schema, items_values, offsets[i], offsets[i+1] - offsets[i], level + 1, childrens, children_type, children_metadata, error) == 1) {
-                    has_error = 1;
-                    return;
-                }
 
-                if (childrens.size() == 1) {
-                    children.emplace_back(childrens[0]);
-                } else {
-                    bool children_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
-                    if (enif_is_identical(childrens[1], kAtomNil)) {
-                        children.emplace_back(kAtomNil);
+                    if (childrens.size() == 1) {
+                        children[i - offset] = childrens[0];
                     } else {
-                        // Use "item" instead of childrens[0] (the schema's name)
-                        children.emplace_back(make_adbc_column(env, schema, values, item_name_term, children_type, children_nullable, children_metadata, childrens[1]));
+                        bool children_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
+                        if (enif_is_identical(childrens[1], kAtomNil)) {
+                            children[i - offset] = kAtomNil;
+                        } else {
+                            // Use "item" instead of childrens[0] (the schema's name)
+                            children[i - offset] = make_adbc_column(env, schema, values, item_name_term, children_type, children_nullable, children_metadata, childrens[1]);
+                        }
                     }
                 }
-            }
+            });
         };
 
         if (list_type == NANOARROW_TYPE_LIST) {
@@ -640,36 +1439,35 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
         if (count == -1) count = values->length;
         if (count > values->length) count = values->length - offset;
         bool items_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
+        const uint8_t * validity_bitmap = items_nullable ? adbc_validity_bitmap(values, offset, count) : nullptr;
 
+        int has_error = 0;
         // Use "item" as the canonical name for list elements
         ERL_NIF_TERM item_name_term = erlang::nif::make_binary(env, "item");
-        for (int64_t child_i = offset; child_i < offset + count; child_i++) {
-            if (bitmap_buffer && items_nullable) {
-                uint8_t vbyte = bitmap_buffer[child_i / 8];
-                if (!(vbyte & (1 << (child_i % 8)))) {
-                    children.emplace_back(kAtomNil);
-                    continue;
+        children.resize(count);
+        visit_valid_runs(offset, count, validity_bitmap, children, [&](int64_t begin, int64_t end) {
+            for (int64_t child_i = begin; child_i < end && !has_error; child_i++) {
+                std::vector<ERL_NIF_TERM> childrens;
+                ERL_NIF_TERM children_type;
+                ERL_NIF_TERM children_metadata;
+                if (arrow_array_to_nif_term(env, items_schema, items_values, child_i * n_items, n_items, level + 1, childrens, children_type, children_metadata, error, false, options, items_node)) {
+                    has_error = 1;
+                    return;
                 }
-            }
-
-            std::vector<ERL_NIF_TERM> childrens;
-            ERL_NIF_TERM children_type;
-            ERL_NIF_TERM children_metadata;
-            if (arrow_array_to_nif_term(env, items_schema, items_values, child_i * n_items, n_items, level + 1, childrens, children_type, children_metadata, error)) {
-                return error;
-            }
-            if (childrens.size() == 1) {
-                children.emplace_back(childrens[0]);
-            } else {
-                bool children_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
-                if (enif_is_identical(childrens[1], kAtomNil)) {
-                    children.emplace_back(kAtomNil);
+                if (childrens.size() == 1) {
+                    children[child_i - offset] = childrens[0];
                 } else {
-                    // Use "item" instead of childrens[0] (the schema's name)
-                    children.emplace_back(make_adbc_column(env, schema, values, item_name_term, children_type, children_nullable, children_metadata, childrens[1]));
+                    bool children_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
+                    if (enif_is_identical(childrens[1], kAtomNil)) {
+                        children[child_i - offset] = kAtomNil;
+                    } else {
+                        // Use "item" instead of childrens[0] (the schema's name)
+                        children[child_i - offset] = make_adbc_column(env, schema, values, item_name_term, children_type, children_nullable, children_metadata, childrens[1]);
+                    }
                 }
             }
-        }
+        });
+        if (has_error) return error;
     }
     return enif_make_list_from_array(env, children.data(), (unsigned)children.size());
 }
@@ -678,7 +1476,7 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
     return get_arrow_array_list_children(env, schema, values, 0, -1, level, list_type, n_items);
 }
 
-ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type) {
+ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, const AdbcMaterializeOptions * options = nullptr, const AdbcDecoderPlanNode * plan_node = nullptr) {
     ERL_NIF_TERM error{};
     if (schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (list view), schema->children == nullptr");
@@ -728,7 +1526,7 @@ ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * sche
     // according to the Arrow spec, the bitmap buffer is not required for the child values
     // and this `buffer[0]` could be a random memory address, so we simply set it to nullptr here
     items_values->buffers[0] = nullptr;
-    if (arrow_array_to_nif_term(env, items_schema, items_values, 0, -1, level + 1, childrens, children_type, children_metadata, error)) {
+    if (arrow_array_to_nif_term(env, items_schema, items_values, 0, -1, level + 1, childrens, children_type, children_metadata, error, false, options, arrow_decoder_plan_child(plan_node, 0))) {
         return error;
     }
     items_values->buffers[0] = bitmap_buffer;
@@ -768,7 +1566,109 @@ ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * sche
     return get_arrow_array_list_view(env, schema, values, 0, -1, level, list_type);
 }
 
-int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &term_type, ERL_NIF_TERM &arrow_metadata, ERL_NIF_TERM &error, bool skip_dictionary_check) {
+template <typename OffsetT> static int expand_list_view(
+    ErlNifEnv *env,
+    struct ArrowSchema * schema,
+    struct ArrowArray * values,
+    int64_t offset,
+    int64_t count,
+    uint64_t level,
+    std::vector<ERL_NIF_TERM> &out,
+    ERL_NIF_TERM &error,
+    const AdbcMaterializeOptions * options,
+    const AdbcDecoderPlanNode * plan_node) {
+    struct ArrowArray * items_values = values->children[0];
+    const uint8_t * validity_bitmap = adbc_validity_bitmap(values, offset, count);
+    const OffsetT * offsets = (const OffsetT *)values->buffers[1];
+    const OffsetT * sizes = (const OffsetT *)values->buffers[2];
+    out.resize(count);
+
+    // the items referenced by the non-null rows, `[items_start, items_end)`
+    int64_t items_start = INT64_MAX;
+    int64_t items_end = 0;
+    bool in_range = true;
+    visit_valid_runs(offset, count, validity_bitmap, out, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end && in_range; i++) {
+            int64_t start = (int64_t)offsets[i];
+            int64_t size = (int64_t)sizes[i];
+            if (start < 0 || size < 0 || start + size > items_values->length) {
+                in_range = false;
+            } else if (size > 0) {
+                items_start = std::min(items_start, start);
+                items_end = std::max(items_end, start + size);
+            }
+        }
+    });
+    if (!in_range) {
+        error = erlang::nif::error(env, "invalid ArrowArray (list view), offset and size out of range");
+        return 1;
+    }
+    if (items_start > items_end) {
+        items_start = items_end;
+    }
+
+    std::vector<ERL_NIF_TERM> items;
+    if (items_end > items_start) {
+        ERL_NIF_TERM items_type;
+        if (arrow_array_to_expanded_terms(env, schema->children[0], items_values, items_start, items_end - items_start, level, items, items_type, error, options, arrow_decoder_plan_child(plan_node, 0)) == 1) {
+            return 1;
+        }
+    }
+    if ((int64_t)items.size() != items_end - items_start) {
+        error = erlang::nif::error(env, "invalid ArrowArray (list view), cannot expand its items");
+        return 1;
+    }
+
+    visit_valid_runs(offset, count, validity_bitmap, out, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; i++) {
+            int64_t size = (int64_t)sizes[i];
+            ERL_NIF_TERM * row_items = size == 0 ? nullptr : items.data() + ((int64_t)offsets[i] - items_start);
+            out[i - offset] = enif_make_list_from_array(env, row_items, (unsigned)size);
+        }
+    });
+    return 0;
+}
+
+/// Decodes `count` rows of a list view array, starting at `offset`,
+/// into a list with the items of each row, or `nil` for null rows.
+///
+/// Only the range of items referenced by these rows is decoded, once,
+/// and each row is sliced out of it with its offset and size.
+///
+/// @return 0 if success, 1 if failed
+static int get_arrow_array_list_view_expanded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, ERL_NIF_TERM &out, ERL_NIF_TERM &error, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
+    if (schema->children == nullptr || schema->n_children != 1) {
+        error = erlang::nif::error(env, "invalid ArrowSchema (list view), schema->n_children != 1");
+        return 1;
+    }
+    if (values->children == nullptr || values->n_children != 1) {
+        error = erlang::nif::error(env, "invalid ArrowArray (list view), values->n_children != 1");
+        return 1;
+    }
+    if (values->n_buffers != 3 || values->buffers[1] == nullptr || values->buffers[2] == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowArray (list view), offsets == nullptr || sizes == nullptr");
+        return 1;
+    }
+
+    if (count == -1) count = values->length;
+    if (count > values->length) count = values->length - offset;
+
+    std::vector<ERL_NIF_TERM> rows;
+    int ret;
+    if (list_type == NANOARROW_TYPE_LIST) {
+        ret = expand_list_view<int32_t>(env, schema, values, offset, count, level, rows, error, options, plan_node);
+    } else {
+        ret = expand_list_view<int64_t>(env, schema, values, offset, count, level, rows, error, options, plan_node);
+    }
+    if (ret != 0) {
+        return 1;
+    }
+
+    out = enif_make_list_from_array(env, rows.data(), (unsigned)rows.size());
+    return 0;
+}
+
+int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &term_type, ERL_NIF_TERM &arrow_metadata, ERL_NIF_TERM &error, bool skip_dictionary_check, const AdbcMaterializeOptions * options, const AdbcDecoderPlanNode * plan_node) {
     if (schema == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema (nullptr) when invoking next");
         return 1;
@@ -781,17 +1681,41 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
     char err_msg_buf[256] = { '\0' };
     const char* format = schema->format ? schema->format : "";
     const char* name = schema->name ? schema->name : "";
+
+    if (plan_node != nullptr && plan_node->decode != nullptr && (skip_dictionary_check || schema->dictionary == nullptr)) {
+        if (count == -1) count = values->length;
+        if (count > values->length) count = values->length - offset;
+        if (!plan_node->accepts_n_buffers(values->n_buffers)) {
+            snprintf(err_msg_buf, sizeof(err_msg_buf), "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != %lld", format, (long long)plan_node->n_buffers);
+            error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
+            return 1;
+        }
+        ERL_NIF_TERM decoded;
+        if (plan_node->decode(env, plan_node, values, offset, count, options, 0, decoded, error) != 0) {
+            return 1;
+        }
+        term_type = enif_make_copy(env, plan_node->type);
+        arrow_metadata = enif_make_copy(env, plan_node->metadata);
+        out_terms.clear();
+        out_terms.emplace_back(enif_make_copy(env, plan_node->name));
+        out_terms.emplace_back(decoded);
+        return 0;
+    }
+
     ERL_NIF_TERM current_term{}, children_term{};
-    size_t format_len = strlen(format);
+    size_t format_len = plan_node ? plan_node->format.size() : strlen(format);
 
     term_type = kAtomNil;
     std::vector<ERL_NIF_TERM> children;
 
-    constexpr int64_t bitmap_buffer_index = 0;
     int64_t data_buffer_index = 1;
     int64_t offset_buffer_index = 2;
 
-    NANOARROW_RETURN_NOT_OK(arrow_metadata_to_nif_term(env, schema->metadata, &arrow_metadata));
+    if (plan_node) {
+        arrow_metadata = enif_make_copy(env, plan_node->metadata);
+    } else {
+        NANOARROW_RETURN_NOT_OK(arrow_metadata_to_nif_term(env, schema->metadata, &arrow_metadata));
+    }
 
     if (!skip_dictionary_check) {
         if (schema->dictionary != nullptr && values->dictionary != nullptr) {
@@ -804,9 +1728,19 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
             // The same holds for ArrowArray structure: while the parent
             // structure points to the index data, the ArrowArray.dictionary
             // points to the dictionary values array.
+            if (arrow_array_is_expandable(schema, options)) {
+                ERL_NIF_TERM expanded;
+                if (get_arrow_dictionary_expanded(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, expanded, term_type, error, options, plan_node) == 1) {
+                    return 1;
+                }
+                out_terms.emplace_back(erlang::nif::make_binary(env, name));
+                out_terms.emplace_back(expanded);
+                return 0;
+            }
+
             term_type = kAdbcColumnTypeDictionary;
 
-            if (get_arrow_dictionary(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, children, error) == 1) {
+            if (get_arrow_dictionary(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, children, error, options, plan_node) == 1) {
                 return 1;
             }
             out_terms.emplace_back(erlang::nif::make_binary(env, name));
@@ -849,7 +1783,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
@@ -867,7 +1801,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
@@ -885,7 +1819,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
@@ -903,7 +1837,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
@@ -921,7 +1855,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
@@ -939,7 +1873,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
@@ -957,7 +1891,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
@@ -975,7 +1909,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
@@ -989,26 +1923,12 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=e), values->n_buffers != 2");
                 return 1;
             }
-            current_term = values_from_buffer(
+            current_term = half_float_values_from_buffer(
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                (const value_type *)values->buffers[data_buffer_index],
-                [](ErlNifEnv *env, const uint16_t u16) -> ERL_NIF_TERM {
-                    float val = float16_to_float(u16);
-                    if (std::isnan(val)) {
-                        return kAtomNaN;
-                    } else if (std::isinf(val)) {
-                        if (val > 0) {
-                            return kAtomInfinity;
-                        } else {
-                            return kAtomNegInfinity;
-                        }
-                    } else {
-                        return enif_make_double(env, val);
-                    }
-                }
+                adbc_validity_bitmap(values, offset, count),
+                (const value_type *)values->buffers[data_buffer_index]
             );
         } else if (format[0] == 'f') {
             // NANOARROW_TYPE_FLOAT
@@ -1024,7 +1944,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 [](ErlNifEnv *env, double val) -> ERL_NIF_TERM {
                     if (std::isnan(val)) {
@@ -1054,7 +1974,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index],
                 [](ErlNifEnv *env, double val) -> ERL_NIF_TERM {
                     if (std::isnan(val)) {
@@ -1084,7 +2004,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const value_type *)values->buffers[data_buffer_index]
             );
         } else if (format[0] == 'u' || format[0] == 'z') {
@@ -1103,16 +2023,14 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=u or format=z), values->n_buffers != 3");
                 return 1;
             }
-            current_term = strings_from_buffer(
+            current_term = binaries_from_buffer(
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const int32_t *)values->buffers[offset_buffer_index],
                 (const uint8_t *)values->buffers[data_buffer_index],
-                [](ErlNifEnv *env, const uint8_t * string_buffers, int32_t offset, size_t nbytes) -> ERL_NIF_TERM {
-                    return erlang::nif::make_binary(env, (const char *)(string_buffers + offset), nbytes);
-                }
+                options
             );
         } else if (format[0] == 'U' || format[0] == 'Z') {
             // NANOARROW_TYPE_LARGE_STRING
@@ -1130,29 +2048,44 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=U or format=Z), values->n_buffers != 3");
                 return 1;
             }
-            current_term = strings_from_buffer(
+            current_term = binaries_from_buffer(
                 env,
                 offset,
                 count,
-                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                adbc_validity_bitmap(values, offset, count),
                 (const int64_t *)values->buffers[offset_buffer_index],
                 (const uint8_t *)values->buffers[data_buffer_index],
-                [](ErlNifEnv *env, const uint8_t * string_buffers, int64_t offset, size_t nbytes) -> ERL_NIF_TERM {
-                    return erlang::nif::make_binary(env, (const char *)(string_buffers + offset), nbytes);
-                }
+                options
             );
         } else {
             format_processed = false;
         }
     } else if (format_len == 2) {
-        if (strncmp("+s", format, 2) == 0) {
+        if (strncmp("vu", format, 2) == 0 || strncmp("vz", format, 2) == 0) {
+            // NANOARROW_TYPE_STRING_VIEW
+            // NANOARROW_TYPE_BINARY_VIEW
+            if (format[1] == 'z') {
+                term_type = kAdbcColumnTypeBinaryView;
+            } else {
+                term_type = kAdbcColumnTypeStringView;
+            }
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers < 3) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=vu or format=vz), values->n_buffers < 3");
+                return 1;
+            }
+            if (binary_views_from_buffer(env, values, offset, count, options, current_term, error) == 1) {
+                return 1;
+            }
+        } else if (strncmp("+s", format, 2) == 0) {
             // NANOARROW_TYPE_STRUCT
             is_struct = true;
             term_type = kAdbcColumnTypeStruct;
 
             if (count == -1) count = values->length;
             if (count > values->length) count = values->length - offset;
-            if (get_arrow_struct(env, schema, values, offset, count, level, children, error) == 1) {
+            if (get_arrow_struct(env, schema, values, offset, count, level, children, error, options, plan_node) == 1) {
                 return 1;
             }
             children_term = enif_make_list_from_array(env, children.data(), (unsigned)children.size());
@@ -1160,19 +2093,31 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
             // NANOARROW_TYPE_RUN_END_ENCODED (maybe in nanoarrow v0.6.0)
             // https://github.com/apache/arrow-nanoarrow/pull/507
             term_type = kAdbcColumnTypeRunEndEncoded;
-            children_term = get_arrow_run_end_encoded(env, schema, values, offset, count, level);
+            if (arrow_array_is_expandable(schema, options)) {
+                if (get_arrow_run_end_encoded_expanded(env, schema, values, offset, count, level, children_term, error, options, plan_node) == 1) {
+                    return 1;
+                }
+            } else {
+                children_term = get_arrow_run_end_encoded(env, schema, values, offset, count, level, options, plan_node);
+            }
         } else if (strncmp("+m", format, 2) == 0) {
             // NANOARROW_TYPE_MAP
             term_type = kAdbcColumnTypeMap;
-            children_term = get_arrow_array_map_children(env, schema, values, offset, count, level);
+            if (arrow_array_is_expandable(schema, options)) {
+                if (get_arrow_array_map_expanded(env, schema, values, offset, count, level, children_term, error, options, plan_node) == 1) {
+                    return 1;
+                }
+            } else {
+                children_term = get_arrow_array_map_children(env, schema, values, offset, count, level, options, plan_node);
+            }
         } else if (strncmp("+l", format, 2) == 0) {
             // NANOARROW_TYPE_LIST
             term_type = kAdbcColumnTypeList;
-            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST);
+            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST, 0, options, plan_node);
         } else if (strncmp("+L", format, 2) == 0) {
             // NANOARROW_TYPE_LARGE_LIST
             term_type = kAdbcColumnTypeLargeList;
-            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST);
+            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST, 0, options, plan_node);
         } else {
             format_processed = false;
         }
@@ -1192,38 +2137,15 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     if (unit == 'D' || unit == 'm') {
                         // NANOARROW_TYPE_DATE32
                         // NANOARROW_TYPE_DATE64
-                        ERL_NIF_TERM date_module = kAtomDateModule;
-                        ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-                        ERL_NIF_TERM keys[] = {
-                            kAtomStructKey,
-                            kAtomCalendarKey,
-                            kAtomYearKey,
-                            kAtomMonthKey,
-                            kAtomDayKey,
-                        };
-
-                        auto convert = [unit, date_module, calendar_iso, &keys](ErlNifEnv *env, uint64_t val) -> ERL_NIF_TERM {
-                            uint64_t seconds;
+                        auto convert = [unit](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
                             if (unit == 'D') {
-                                seconds = val * 24 * 60 * 60; // days
+                                return adbc_calendar_date(env, val); // days
                             } else {
-                                seconds = val / 1000; // milliseconds
+                                return adbc_calendar_date(env, adbc_floor_div(val, 86400000)); // milliseconds
                             }
-                            time_t t = (time_t)seconds;
-                            tm* time = gmtime(&t);
-                            ERL_NIF_TERM ex_date;
-                            ERL_NIF_TERM values[] = {
-                                date_module,
-                                calendar_iso,
-                                enif_make_int(env, time->tm_year + 1900),
-                                enif_make_int(env, time->tm_mon + 1),
-                                enif_make_int(env, time->tm_mday)
-                            };
-                            enif_make_map_from_arrays(env, keys, values, 5, &ex_date);
-                            return ex_date;
                         };
                         if (unit == 'D') {
-                            using value_type = uint32_t;
+                            using value_type = int32_t;
                             term_type = kAdbcColumnTypeDate32;
                             if (count == -1) count = values->length;
                             if (count > values->length) count = values->length - offset;
@@ -1235,12 +2157,12 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                                 env,
                                 offset,
                                 count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                                adbc_validity_bitmap(values, offset, count),
                                 (const value_type *)values->buffers[data_buffer_index],
                                 convert
                             );
                         } else {
-                            using value_type = uint64_t;
+                            using value_type = int64_t;
                             term_type = kAdbcColumnTypeDate64;
                             if (count == -1) count = values->length;
                             if (count > values->length) count = values->length - offset;
@@ -1252,7 +2174,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                                 env,
                                 offset,
                                 count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                                adbc_validity_bitmap(values, offset, count),
                                 (const value_type *)values->buffers[data_buffer_index],
                                 convert
                             );
@@ -1267,30 +2189,25 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     // ttm - time32 [milliseconds]
                     // ttu - time64 [microseconds]
                     // ttn - time64 [nanoseconds]
-                    uint64_t unit;
                     uint8_t us_precision;
                     switch (format[2]) {
                         case 's': // seconds
                             // NANOARROW_TYPE_TIME32
-                            unit = 1000000000;
                             us_precision = 0;
                             term_type = kAdbcColumnTypeTime32Seconds;
                             break;
                         case 'm': // milliseconds
                             // NANOARROW_TYPE_TIME32
-                            unit = 1000000;
                             us_precision = 3;
                             term_type = kAdbcColumnTypeTime32Milliseconds;
                             break;
                         case 'u': // microseconds
                             // NANOARROW_TYPE_TIME64
-                            unit = 1000;
                             us_precision = 6;
                             term_type = kAdbcColumnTypeTime64Microseconds;
                             break;
                         case 'n': // nanoseconds
                             // NANOARROW_TYPE_TIME64
-                            unit = 1;
                             us_precision = 6;
                             term_type = kAdbcColumnTypeTime64Nanoseconds;
                             break;
@@ -1299,7 +2216,6 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     }
 
                     if (format_processed) {
-                        using value_type = uint64_t;
                         if (count == -1) count = values->length;
                         if (count > values->length) count = values->length - offset;
                         if (values->n_buffers != 2) {
@@ -1307,44 +2223,34 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                             return 1;
                         }
 
-                        ERL_NIF_TERM keys[] = {
-                            kAtomStructKey,
-                            kAtomCalendarKey,
-                            kAtomHourKey,
-                            kAtomMinuteKey,
-                            kAtomSecondKey,
-                            kAtomMicrosecondKey,
+                        // Elixir only supports microsecond precision
+                        char time_unit = format[2];
+                        auto convert = [time_unit, us_precision](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                            int64_t seconds, us;
+                            adbc_calendar_split(val, time_unit, seconds, us);
+                            return adbc_calendar_time(env, seconds, us, us_precision);
                         };
-
-                        ERL_NIF_TERM time_module = kAtomTimeModule;
-                        ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-
-                        current_term = values_from_buffer(
-                            env,
-                            offset,
-                            count,
-                            (const uint8_t *)values->buffers[bitmap_buffer_index],
-                            (const value_type *)values->buffers[data_buffer_index],
-                            [unit, us_precision, time_module, calendar_iso, &keys](ErlNifEnv *env, uint64_t val) -> ERL_NIF_TERM {
-                                // Elixir only supports microsecond precision
-                                uint64_t us = val * unit / 1000;
-                                time_t s = (time_t)(us / 1000000);
-                                tm* time = gmtime(&s);
-                                us = us % 1000000;
-
-                                ERL_NIF_TERM ex_time;
-                                ERL_NIF_TERM values[] = {
-                                    time_module,
-                                    calendar_iso,
-                                    enif_make_int(env, time->tm_hour),
-                                    enif_make_int(env, time->tm_min),
-                                    enif_make_int(env, time->tm_sec),
-                                    enif_make_tuple2(env, enif_make_int(env, us), enif_make_int(env, us_precision))
-                                };
-                                enif_make_map_from_arrays(env, keys, values, 6, &ex_time);
-                                return ex_time;
-                            }
-                    );
+                        if (time_unit == 's' || time_unit == 'm') {
+                            // time32
+                            current_term = values_from_buffer(
+                                env,
+                                offset,
+                                count,
+                                adbc_validity_bitmap(values, offset, count),
+                                (const int32_t *)values->buffers[data_buffer_index],
+                                convert
+                            );
+                        } else {
+                            // time64
+                            current_term = values_from_buffer(
+                                env,
+                                offset,
+                                count,
+                                adbc_validity_bitmap(values, offset, count),
+                                (const int64_t *)values->buffers[data_buffer_index],
+                                convert
+                            );
+                        }
                     }
                 // timestamp
                 } else if (format[1] == 'D') {
@@ -1385,7 +2291,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                             env,
                             offset,
                             count,
-                            (const uint8_t *)values->buffers[bitmap_buffer_index],
+                            adbc_validity_bitmap(values, offset, count),
                             (const value_type *)values->buffers[data_buffer_index],
                             enif_make_int64
                         );
@@ -1425,7 +2331,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                                 env,
                                 offset,
                                 count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                                adbc_validity_bitmap(values, offset, count),
                                 (const value_type *)values->buffers[data_buffer_index],
                                 enif_make_int64
                             );
@@ -1442,7 +2348,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                                 env,
                                 offset,
                                 count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                                adbc_validity_bitmap(values, offset, count),
                                 (const value_type *)values->buffers[data_buffer_index],
                                 [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
                                     int32_t days = val & 0xFFFFFFFF;
@@ -1465,7 +2371,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                                 env,
                                 offset,
                                 count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                                adbc_validity_bitmap(values, offset, count),
                                 (const value_type *)values->buffers[data_buffer_index],
                                 [](ErlNifEnv *env, value_type val) -> ERL_NIF_TERM {
                                     int32_t months = val.data[0] & 0xFFFFFFFF;
@@ -1494,28 +2400,23 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 // it should be in the format like `tsu:timezone`
 
                 // NANOARROW_TYPE_TIMESTAMP
-                uint64_t unit;
                 uint8_t us_precision;
                 ERL_NIF_TERM term_unit;
                 ERL_NIF_TERM term_timezone = kAtomNil;
                 switch (format[2]) {
                     case 's': // seconds
-                        unit = 1000000000;
                         us_precision = 0;
                         term_unit = kAtomSeconds;
                         break;
                     case 'm': // milliseconds
-                        unit = 1000000;
                         us_precision = 3;
                         term_unit = kAtomMilliseconds;
                         break;
                     case 'u': // microseconds
-                        unit = 1000;
                         us_precision = 6;
                         term_unit = kAtomMicroseconds;
                         break;
                     case 'n': // nanoseconds
-                        unit = 1;
                         us_precision = 6;
                         term_unit = kAtomNanoseconds;
                         break;
@@ -1538,49 +2439,18 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                         return 1;
                     }
 
-                    ERL_NIF_TERM naive_dt_module = kAtomNaiveDateTimeModule;
-                    ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-
-                    ERL_NIF_TERM keys[] = {
-                        kAtomStructKey,
-                        kAtomCalendarKey,
-                        kAtomYearKey,
-                        kAtomMonthKey,
-                        kAtomDayKey,
-                        kAtomHourKey,
-                        kAtomMinuteKey,
-                        kAtomSecondKey,
-                        kAtomMicrosecondKey,
-                    };
-
+                    // Elixir only supports microsecond precision
+                    char timestamp_unit = format[2];
                     current_term = values_from_buffer(
                         env,
                         offset,
                         count,
-                        (const uint8_t *)values->buffers[bitmap_buffer_index],
+                        adbc_validity_bitmap(values, offset, count),
                         (const value_type *)values->buffers[data_buffer_index],
-                        [unit, us_precision, naive_dt_module, calendar_iso, &keys](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
-                            // Elixir only supports microsecond precision
-                            int64_t us = val * unit / 1000;
-                            time_t t = (time_t)(us / 1000000);
-                            tm* time = gmtime(&t);
-                            us = us % 1000000;
-
-                            ERL_NIF_TERM ex_dt;
-                            ERL_NIF_TERM values[] = {
-                                naive_dt_module,
-                                calendar_iso,
-                                enif_make_int(env, time->tm_year + 1900),
-                                enif_make_int(env, time->tm_mon + 1),
-                                enif_make_int(env, time->tm_mday),
-                                enif_make_int(env, time->tm_hour),
-                                enif_make_int(env, time->tm_min),
-                                enif_make_int(env, time->tm_sec),
-                                enif_make_tuple2(env, enif_make_int(env, us), enif_make_int(env, us_precision))
-                            };
-
-                            enif_make_map_from_arrays(env, keys, values, 9, &ex_dt);
-                            return ex_dt;
+                        [timestamp_unit, us_precision](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                            int64_t seconds, us;
+                            adbc_calendar_split(val, timestamp_unit, seconds, us);
+                            return adbc_calendar_naive_datetime(env, seconds, us, us_precision);
                         }
                     );
                 }
@@ -1591,11 +2461,23 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
             if (format_len == 3 && strncmp("+vl", format, 3) == 0) {
                 // NANOARROW_TYPE_LIST(VIEW)
                 term_type = kAdbcColumnTypeListView;
-                children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST);
+                if (arrow_array_is_expandable(schema, options)) {
+                    if (get_arrow_array_list_view_expanded(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST, children_term, error, options, plan_node) == 1) {
+                        return 1;
+                    }
+                } else {
+                    children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST, options, plan_node);
+                }
             } else if (format_len == 3 && strncmp("+vL", format, 3) == 0) {
                 // NANOARROW_TYPE_LARGE_LIST(VIEW)
                 term_type = kAdbcColumnTypeLargeListView;
-                children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST);
+                if (arrow_array_is_expandable(schema, options)) {
+                    if (get_arrow_array_list_view_expanded(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST, children_term, error, options, plan_node) == 1) {
+                        return 1;
+                    }
+                } else {
+                    children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST, options, plan_node);
+                }
             } else if (strncmp("+w:", format, 3) == 0) {
                 // NANOARROW_TYPE_FIXED_SIZE_LIST
                 unsigned n_items = 0;
@@ -1603,7 +2485,7 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     n_items = n_items * 10 + (format[i] - '0');
                 }
                 term_type = kAdbcColumnTypeFixedSizeList(n_items);
-                children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_FIXED_SIZE_LIST, n_items);
+                children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_FIXED_SIZE_LIST, n_items, options, plan_node);
             } else if (strncmp("w:", format, 2) == 0) {
                 // NANOARROW_TYPE_FIXED_SIZE_BINARY
                 if (count == -1) count = values->length;
@@ -1618,25 +2500,42 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     nbytes = nbytes * 10 + (format[i] - '0');
                 }
                 term_type = kAdbcColumnTypeFixedSizeBinary(nbytes);
-                current_term = fixed_size_binary_from_buffer(
-                    env,
-                    offset,
-                    count,
-                    nbytes,
-                    (const uint8_t *)values->buffers[bitmap_buffer_index],
-                    (const uint8_t *)values->buffers[data_buffer_index],
-                    [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
-                        return erlang::nif::make_binary(env, (const char *)val, nbytes);
-                    }
-                );
+                const uint8_t * fixed_size_data = (const uint8_t *)values->buffers[data_buffer_index];
+                ERL_NIF_TERM parent;
+                if (count > 0 && fixed_size_data != nullptr && make_zero_copy_binary(env, options, fixed_size_data + offset * nbytes, count * nbytes, parent)) {
+                    const uint8_t * parent_data = fixed_size_data + offset * nbytes;
+                    current_term = fixed_size_binary_from_buffer(
+                        env,
+                        offset,
+                        count,
+                        nbytes,
+                        adbc_validity_bitmap(values, offset, count),
+                        fixed_size_data,
+                        [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+                            return enif_make_sub_binary(env, parent, val - parent_data, nbytes);
+                        }
+                    );
+                } else {
+                    current_term = fixed_size_binary_from_buffer(
+                        env,
+                        offset,
+                        count,
+                        nbytes,
+                        adbc_validity_bitmap(values, offset, count),
+                        fixed_size_data,
+                        [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+                            return erlang::nif::make_binary(env, (const char *)val, nbytes);
+                        }
+                    );
+                }
             } else if (format_len > 4 && (strncmp("+ud:", format, 4) == 0)) {
                 // NANOARROW_TYPE_DENSE_UNION
                 term_type = kAdbcColumnTypeDenseUnion;
-                children_term = get_arrow_array_dense_union_children(env, schema, values, offset, count, level);
+                children_term = get_arrow_array_dense_union_children(env, schema, values, offset, count, level, options, plan_node);
             } else if (format_len > 4 && (strncmp("+us:", format, 4) == 0)) {
                 // NANOARROW_TYPE_SPARSE_UNION
                 term_type = kAdbcColumnTypeSparseUnion;
-                children_term = get_arrow_array_sparse_union_children(env, schema, values, offset, count, level);
+                children_term = get_arrow_array_sparse_union_children(env, schema, values, offset, count, level, options, plan_node);
             } else if (strncmp("d:", format, 2) == 0) {
                 // NANOARROW_TYPE_DECIMAL128
                 // NANOARROW_TYPE_DECIMAL256
@@ -1673,15 +2572,20 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                         error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
                         return 1;
                     }
+                    if (bits != 32 && bits != 64 && bits != 128 && bits != 256) {
+                        snprintf(err_msg_buf, 255, "invalid bit width for ArrowArray (format=%s), expected 32, 64, 128 or 256", schema->format);
+                        error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
+                        return 1;
+                    }
                     current_term = fixed_size_binary_from_buffer(
                         env,
                         offset,
                         count,
                         bits / 8,
-                        (const uint8_t *)values->buffers[bitmap_buffer_index],
+                        adbc_validity_bitmap(values, offset, count),
                         (const uint8_t *)values->buffers[data_buffer_index],
                         [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
-                            return erlang::nif::make_binary(env, (const char *)val, bits / 8);
+                            return adbc_decimal_to_nif(env, val, bits, scale);
                         }
                     );
                 }
@@ -1725,8 +2629,8 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
     return 0;
 }
 
-int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &out_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check) {
-    return arrow_array_to_nif_term(env, schema, values, 0, -1, level, out_terms, out_type, metadata, error, skip_dictionary_check);
+int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &out_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check, const AdbcMaterializeOptions * options) {
+    return arrow_array_to_nif_term(env, schema, values, 0, -1, level, out_terms, out_type, metadata, error, skip_dictionary_check, options);
 }
 
 #endif  // ADBC_ARROW_ARRAY_HPP
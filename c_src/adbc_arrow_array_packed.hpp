@@ -0,0 +1,159 @@
+#ifndef ADBC_ARROW_ARRAY_PACKED_HPP
+#define ADBC_ARROW_ARRAY_PACKED_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+#include "adbc_bitmap.hpp"
+#include "adbc_consts.h"
+#include "nif_utils.hpp"
+
+/// Returns the width in bytes of a single value of the given format
+/// if the column can be returned in packed mode, 0 otherwise.
+///
+/// Packed columns are the fixed-width primitive types, together with
+/// date, time, timestamp and duration, whose values are stored as plain
+/// integers in the data buffer.
+static size_t arrow_packed_element_size(const char * format) {
+    if (format == nullptr) return 0;
+    size_t format_len = strlen(format);
+    if (format_len == 1) {
+        switch (format[0]) {
+            case 'c':
+            case 'C':
+                return 1;
+            case 's':
+            case 'S':
+            case 'e':
+                return 2;
+            case 'i':
+            case 'I':
+            case 'f':
+                return 4;
+            case 'l':
+            case 'L':
+            case 'g':
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    if (format_len >= 3 && format[0] == 't') {
+        if (format_len == 3 && format[1] == 'd') {
+            // date32 (days) or date64 (milliseconds)
+            if (format[2] == 'D') return 4;
+            if (format[2] == 'm') return 8;
+        } else if (format_len == 3 && format[1] == 't') {
+            // time32 (seconds, milliseconds) or time64 (microseconds, nanoseconds)
+            if (format[2] == 's' || format[2] == 'm') return 4;
+            if (format[2] == 'u' || format[2] == 'n') return 8;
+        } else if (format[1] == 's' && format_len >= 4 && format[3] == ':') {
+            // timestamp, with an optional timezone after the colon
+            if (format[2] == 's' || format[2] == 'm' || format[2] == 'u' || format[2] == 'n') return 8;
+        } else if (format_len == 3 && format[1] == 'D') {
+            // duration
+            if (format[2] == 's' || format[2] == 'm' || format[2] == 'u' || format[2] == 'n') return 8;
+        }
+    }
+
+    return 0;
+}
+
+static bool arrow_packed_has_validity(const struct ArrowArray * values) {
+    return values->null_count != 0 && values->n_buffers > 0 && values->buffers[0] != nullptr;
+}
+
+/// @return true if a single chunk is returned as references to its buffers,
+/// its validity bitmap is copied when it does not start at a byte boundary
+static bool arrow_packed_is_zero_copy(const struct ArrowArray * values) {
+    return !arrow_packed_has_validity(values) || values->offset % 8 == 0;
+}
+
+/// Returns the values of one or more chunks of a packed column as
+/// `{values, validity, length}`.
+///
+/// `values` is a little-endian binary holding `length` values back to back,
+/// and `validity` is an Arrow (LSB-first) bitmap starting at bit 0 or `nil`
+/// if none of the values is null.
+///
+/// When there is only one chunk and its offset allows it, the binaries
+/// reference the Arrow buffers owned by `owners[0]` instead of copying them.
+/// Bits of `validity` past `length` are unspecified.
+///
+/// @return 0 if success, 1 if failed
+static int arrow_arrays_to_packed_nif_term(
+    ErlNifEnv *env,
+    const std::vector<struct ArrowArray *> &chunks,
+    const std::vector<void *> &owners,
+    size_t element_size,
+    ERL_NIF_TERM &out,
+    ERL_NIF_TERM &error) {
+    int64_t total_length = 0;
+    bool has_validity = false;
+    for (auto chunk : chunks) {
+        if (chunk->n_buffers != 2) {
+            error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray in packed mode, values->n_buffers != 2");
+            return 1;
+        }
+        total_length += chunk->length;
+        has_validity = has_validity || arrow_packed_has_validity(chunk);
+    }
+
+    ERL_NIF_TERM values_term;
+    ERL_NIF_TERM validity_term = kAtomNil;
+    if (chunks.size() == 1 && owners[0] != nullptr && total_length > 0) {
+        struct ArrowArray * chunk = chunks[0];
+        const uint8_t * data = (const uint8_t *)chunk->buffers[1];
+        values_term = enif_make_resource_binary(env, owners[0], data + chunk->offset * element_size, total_length * element_size);
+        if (has_validity && arrow_packed_is_zero_copy(chunk)) {
+            const uint8_t * bitmap = (const uint8_t *)chunk->buffers[0];
+            validity_term = enif_make_resource_binary(env, owners[0], bitmap + chunk->offset / 8, (total_length + 7) / 8);
+            has_validity = false;
+        }
+    } else {
+        ErlNifBinary values_binary;
+        if (!enif_alloc_binary(total_length * element_size, &values_binary)) {
+            error = erlang::nif::error(env, "out of memory");
+            return 1;
+        }
+        size_t pos = 0;
+        for (auto chunk : chunks) {
+            size_t nbytes = chunk->length * element_size;
+            if (nbytes > 0) {
+                memcpy(values_binary.data + pos, (const uint8_t *)chunk->buffers[1] + chunk->offset * element_size, nbytes);
+            }
+            pos += nbytes;
+        }
+        values_term = enif_make_binary(env, &values_binary);
+    }
+
+    if (has_validity) {
+        ErlNifBinary validity_binary;
+        if (!enif_alloc_binary((total_length + 7) / 8, &validity_binary)) {
+            error = erlang::nif::error(env, "out of memory");
+            return 1;
+        }
+        memset(validity_binary.data, 0, validity_binary.size);
+        // copied 64 bits at a time, the chunks are not byte-aligned in the result
+        int64_t bit = 0;
+        for (auto chunk : chunks) {
+            const uint8_t * bitmap = arrow_packed_has_validity(chunk) ? (const uint8_t *)chunk->buffers[0] : nullptr;
+            for (int64_t i = 0; i < chunk->length; i += 64) {
+                int nbits = chunk->length - i < 64 ? (int)(chunk->length - i) : 64;
+                uint64_t word = bitmap ? adbc_bitmap_load(bitmap, chunk->offset + i, nbits) : ~(uint64_t)0;
+                adbc_bitmap_or(validity_binary.data, bit + i, word, nbits);
+            }
+            bit += chunk->length;
+        }
+        validity_term = enif_make_binary(env, &validity_binary);
+    }
+
+    out = enif_make_tuple3(env, values_term, validity_term, enif_make_int64(env, total_length));
+    return 0;
+}
+
+#endif  // ADBC_ARROW_ARRAY_PACKED_HPP
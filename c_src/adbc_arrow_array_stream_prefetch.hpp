@@ -0,0 +1,238 @@
+#ifndef ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
+#define ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+
+/// Reads the batches of an ArrowArrayStream on a native thread, ahead of
+/// the consumer, keeping at most `depth` of them in a queue.
+///
+/// When the consumer finds the queue empty, it asks to be notified and the
+/// thread sends `{:adbc_stream_ready, tag}` to it as soon as the next batch,
+/// the end of the stream or an error is available.
+///
+/// The stream is moved into the prefetch, so the thread does not keep the
+/// resource it came from. `destroy` stops the thread and releases the stream.
+/// If the resource is collected instead, `abandon` only asks the thread to
+/// stop, and it's joined later by `reap`.
+struct ArrowArrayStreamPrefetch {
+    struct ArrowArrayStream stream{};
+    size_t depth = 0;
+    // sent to the consumer so that it can tell which stream is ready
+    uint64_t tag = 0;
+
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+    ErlNifTid tid;
+    ErlNifEnv * msg_env = nullptr;
+
+    // all fields below are guarded by `mutex`
+    std::deque<struct ArrowArray> batches;
+    bool ended = false;
+    bool failed = false;
+    std::string reason;
+    bool stop = false;
+    bool notify = false;
+    ErlNifPid consumer;
+
+    // next prefetch whose thread is waiting to be joined by `reap`
+    ArrowArrayStreamPrefetch * next_abandoned = nullptr;
+
+    /// Starts reading `stream` on a new thread
+    ///
+    /// `stream` is moved into the prefetch and marked as released,
+    /// it's left as it was if the thread cannot be started.
+    /// @return nullptr if failed
+    static ArrowArrayStreamPrefetch * start(struct ArrowArrayStream * stream, size_t depth) {
+        static std::atomic<uint64_t> next_tag{1};
+
+        reap();
+        auto prefetch = new ArrowArrayStreamPrefetch();
+        prefetch->depth = depth > 0 ? depth : 1;
+        prefetch->tag = next_tag.fetch_add(1);
+
+        char mutex_name[] = "adbc_prefetch_mutex";
+        char cond_name[] = "adbc_prefetch_cond";
+        char thread_name[] = "adbc_prefetch";
+        prefetch->mutex = enif_mutex_create(mutex_name);
+        prefetch->cond = enif_cond_create(cond_name);
+        prefetch->msg_env = enif_alloc_env();
+        if (prefetch->mutex == nullptr || prefetch->cond == nullptr || prefetch->msg_env == nullptr) {
+            prefetch->free_resources();
+            delete prefetch;
+            return nullptr;
+        }
+        prefetch->stream = *stream;
+        stream->release = nullptr;
+        if (enif_thread_create(thread_name, &prefetch->tid, ArrowArrayStreamPrefetch::run, prefetch, nullptr) != 0) {
+            *stream = prefetch->stream;
+            prefetch->free_resources();
+            delete prefetch;
+            return nullptr;
+        }
+        return prefetch;
+    }
+
+    /// Stops the thread, releases the batches that were not consumed
+    /// and the stream, and frees `prefetch`
+    static void destroy(ArrowArrayStreamPrefetch * prefetch) {
+        prefetch->request_stop();
+        enif_thread_join(prefetch->tid, nullptr);
+        if (prefetch->stream.release) {
+            prefetch->stream.release(&prefetch->stream);
+        }
+        prefetch->free_batches_and_resources();
+    }
+
+    /// Asks the thread to stop, releases the batches that were not consumed,
+    /// and leaves `prefetch` to be freed by `reap` without waiting for its thread
+    ///
+    /// Called once the resource the stream came from has been collected. Like
+    /// the stream of any collected resource, the stream is not released here,
+    /// it's only released by `destroy`.
+    static void abandon(ArrowArrayStreamPrefetch * prefetch) {
+        prefetch->request_stop();
+
+        prefetch->next_abandoned = abandoned().load();
+        while (!abandoned().compare_exchange_weak(prefetch->next_abandoned, prefetch)) {
+        }
+    }
+
+    /// Joins the threads of the abandoned prefetches and frees them
+    static void reap() {
+        auto prefetch = abandoned().exchange(nullptr);
+        while (prefetch != nullptr) {
+            auto next = prefetch->next_abandoned;
+            enif_thread_join(prefetch->tid, nullptr);
+            prefetch->free_batches_and_resources();
+            prefetch = next;
+        }
+    }
+
+    /// Takes the next batch from the queue
+    ///
+    /// If the queue is empty and `notify_pid` is not nullptr, that process
+    /// is notified once the queue changes.
+    ///
+    /// @return 0 if success, `out->release` is nullptr at the end of the stream,
+    ///         1 if reading the stream failed, with `reason` set,
+    ///         2 if no batch is available yet
+    int pop(struct ArrowArray * out, ErlNifPid * notify_pid, std::string &reason) {
+        int ret = 0;
+        enif_mutex_lock(this->mutex);
+        // the consumer is only notified while it's waiting
+        this->notify = false;
+        if (!this->batches.empty()) {
+            *out = this->batches.front();
+            this->batches.pop_front();
+            enif_cond_signal(this->cond);
+        } else if (this->failed) {
+            reason = this->reason;
+            ret = 1;
+        } else if (this->ended) {
+            out->release = nullptr;
+        } else {
+            if (notify_pid != nullptr) {
+                this->notify = true;
+                this->consumer = *notify_pid;
+            }
+            ret = 2;
+        }
+        enif_mutex_unlock(this->mutex);
+        return ret;
+    }
+
+private:
+    static void * run(void * arg) {
+        auto self = (ArrowArrayStreamPrefetch *)arg;
+        enif_mutex_lock(self->mutex);
+        while (!self->stop) {
+            if (self->batches.size() >= self->depth) {
+                enif_cond_wait(self->cond, self->mutex);
+                continue;
+            }
+            enif_mutex_unlock(self->mutex);
+
+            struct ArrowArray array{};
+            int code = self->stream.get_next(&self->stream, &array);
+            const char * last_error = code != 0 ? self->stream.get_last_error(&self->stream) : nullptr;
+
+            enif_mutex_lock(self->mutex);
+            if (code != 0) {
+                self->failed = true;
+                self->reason = last_error ? last_error : "unknown error: cannot get next record with record->val.values";
+            } else if (array.release == nullptr) {
+                self->ended = true;
+            } else if (self->stop) {
+                array.release(&array);
+            } else {
+                self->batches.push_back(array);
+            }
+
+            if (self->notify) {
+                self->notify = false;
+                ERL_NIF_TERM msg = enif_make_tuple2(self->msg_env,
+                    enif_make_atom(self->msg_env, "adbc_stream_ready"),
+                    enif_make_uint64(self->msg_env, self->tag));
+                enif_send(nullptr, &self->consumer, self->msg_env, msg);
+            }
+            if (self->failed || self->ended) {
+                break;
+            }
+        }
+        enif_mutex_unlock(self->mutex);
+        return nullptr;
+    }
+
+    /// Wakes the thread up so that it exits, and releases the batches it read
+    void request_stop() {
+        enif_mutex_lock(this->mutex);
+        this->stop = true;
+        for (auto &batch : this->batches) {
+            if (batch.release) {
+                batch.release(&batch);
+            }
+        }
+        this->batches.clear();
+        enif_cond_broadcast(this->cond);
+        enif_mutex_unlock(this->mutex);
+    }
+
+    static std::atomic<ArrowArrayStreamPrefetch *> &abandoned() {
+        static std::atomic<ArrowArrayStreamPrefetch *> list{nullptr};
+        return list;
+    }
+
+    void free_batches_and_resources() {
+        for (auto &batch : this->batches) {
+            if (batch.release) {
+                batch.release(&batch);
+            }
+        }
+        this->batches.clear();
+        this->free_resources();
+        delete this;
+    }
+
+    void free_resources() {
+        if (this->msg_env) {
+            enif_free_env(this->msg_env);
+            this->msg_env = nullptr;
+        }
+        if (this->cond) {
+            enif_cond_destroy(this->cond);
+            this->cond = nullptr;
+        }
+        if (this->mutex) {
+            enif_mutex_destroy(this->mutex);
+            this->mutex = nullptr;
+        }
+    }
+};
+
+#endif  // ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
@@ -3,11 +3,57 @@
 #pragma once
 
 #include <arrow-adbc/adbc.h>
+#include "adbc_arrow_array_stream_prefetch.hpp"
+#include "adbc_decoder_plan.hpp"
+
+/// Kept in `private_data` of an ArrowArrayStream resource once the stream
+/// has returned its first batch or has been configured for rebatching
+struct ArrowArrayStreamState {
+    // NifRes<AdbcDecoderPlan> that owns the schema of the stream,
+    // nullptr until the first batch is read
+    void * plan_resource;
+
+    // driver batches are read in one call until either limit is reached,
+    // 0 means no limit, rebatching is disabled when both are 0
+    int64_t target_rows;
+    int64_t target_bytes;
+
+    // set when the driver has reported the end of the stream
+    // while batches were being accumulated
+    bool ended;
+
+    // a driver batch that would have exceeded the rebatch target, it is
+    // returned first by the next call, `pending.release` is nullptr if none
+    struct ArrowArray pending;
+
+    // number of batches read ahead of the consumer, 0 to disable it,
+    // `prefetch` is started by the first call to read the stream
+    int64_t prefetch_depth;
+    ArrowArrayStreamPrefetch * prefetch;
+};
 
 struct ArrowArrayStreamRecord {
     struct ArrowSchema *schema = nullptr;
     struct ArrowArray *values = nullptr;
 
+    // NifRes<AdbcDecoderPlan> of the stream this record comes from,
+    // and the node in it that decodes `schema`
+    //
+    // when set, `schema` is borrowed from the plan and must not be released
+    void * plan_resource = nullptr;
+    const AdbcDecoderPlanNode * plan_node = nullptr;
+
+    /// Allocate memory for values only, `schema` is borrowed from `plan_resource`
+    /// @return 0 if success, 1 if failed
+    int allocate_values() {
+        this->values = (struct ArrowArray *)enif_alloc(sizeof(struct ArrowArray));
+        if (this->values == nullptr) {
+            return 1;
+        }
+        memset(this->values, 0, sizeof(struct ArrowArray));
+        return 0;
+    }
+
     /// Allocate memory for schema and values
     /// @return 0 if success, 1 if failed
     int allocate_schema_and_values() {
@@ -14,9 +14,50 @@
 #include "adbc_column.hpp"
 #include "nif_utils.hpp"
 
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error);
+static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, void * plan_resource = nullptr);
+
+/// Moves `child_array` into a new ArrowArrayStreamRecord resource
+///
+/// If `plan_resource` is given, the record borrows `child_schema` from the
+/// decoder plan, otherwise it gets a deep copy of it.
+/// @return 0 if success, 1 if failed
+static int arrow_array_to_stream_record(ErlNifEnv *env, struct ArrowSchema * child_schema, struct ArrowArray * child_array, void * plan_resource, int64_t child_i, ERL_NIF_TERM &data_ref, ERL_NIF_TERM &error) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    auto * record = record_type::allocate_resource(env, error);
+    if (record == nullptr) {
+        return 1;
+    }
+    if (plan_resource != nullptr) {
+        // `child_schema` is owned by the decoder plan, share it instead of copying it
+        if (record->val.allocate_values()) {
+            enif_release_resource(record);
+            error = erlang::nif::error(env, "out of memory");
+            return 1;
+        }
+        auto plan = (NifRes<struct AdbcDecoderPlan> *)plan_resource;
+        enif_keep_resource(plan_resource);
+        record->val.plan_resource = plan_resource;
+        record->val.schema = child_schema;
+        if (plan->val.root != nullptr) {
+            record->val.plan_node = &plan->val.root->children[child_i];
+        }
+    } else {
+        if (record->val.allocate_schema_and_values()) {
+            enif_release_resource(record);
+            error = erlang::nif::error(env, "out of memory");
+            return 1;
+        }
+        ArrowSchemaDeepCopy(child_schema, record->val.schema);
+    }
+    ArrowArrayMove(child_array, record->val.values);
+    memset(child_array, 0, sizeof(struct ArrowArray));
+    data_ref = record->make_resource(env);
+    // the term now owns the record
+    enif_release_resource(record);
+    return 0;
+}
 
-static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error, void * plan_resource = nullptr) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr while schema->n_children > 0");
         return 1;
@@ -32,20 +73,10 @@ static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, struct
         }
 
         if (level == 0) {
-            using record_type = NifRes<struct ArrowArrayStreamRecord>;
-            auto * record = record_type::allocate_resource(env, error);
-            if (record == nullptr) {
-                return 1;
-            }
-            if (record->val.allocate_schema_and_values()) {
-                error = erlang::nif::error(env, "out of memory");
+            ERL_NIF_TERM data_ref;
+            if (arrow_array_to_stream_record(env, child_schema, array->children[child_i], plan_resource, child_i, data_ref, error) != 0) {
                 return 1;
             }
-            struct ArrowArray * child_array = array->children[child_i];
-            ArrowSchemaDeepCopy(child_schema, record->val.schema);
-            ArrowArrayMove(child_array, record->val.values);
-            memset(array->children[child_i], 0, sizeof(struct ArrowArray));
-            ERL_NIF_TERM data_ref = record->make_resource(env);
 
             children[child_i] = make_adbc_column(env, child_schema, child_type, child_metadata, data_ref);
         } else {
@@ -174,13 +205,13 @@ static int get_list_element_schema(ErlNifEnv *env, struct ArrowSchema * schema,
     return 0;
 }
 
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &error) {
+static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &error, void * plan_resource = nullptr) {
     ERL_NIF_TERM type_term, metadata;
     int level = 0;
-    return arrow_schema_to_nif_term(env, schema, array, level, out_terms, type_term, metadata, error);
+    return arrow_schema_to_nif_term(env, schema, array, level, out_terms, type_term, metadata, error, plan_resource);
 }
 
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &type_term, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error) {
+static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &type_term, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, void * plan_resource) {
     if (schema == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema (nullptr) when invoking next");
         return 1;
@@ -239,7 +270,7 @@ static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema,
     } else if (format_len == 2) {
         if (strncmp("+s", format, 2) == 0) {
             // NANOARROW_TYPE_STRUCT
-            if (get_struct_schema(env, schema, array, level, children, error) != 0) {
+            if (get_struct_schema(env, schema, array, level, children, error, plan_resource) != 0) {
                 return 1;
             }
 
@@ -443,4 +474,116 @@ static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema,
     return 0;
 }
 
+/// Builds the `%Adbc.Column{}` of every column of the stream once, in the env of the plan
+///
+/// Sets `plan.has_column_templates` if success.
+static void arrow_decoder_plan_build_column_templates(AdbcDecoderPlan &plan) {
+    plan.has_column_templates = false;
+    struct ArrowSchema * schema = &plan.schema;
+    if (plan.root == nullptr || plan.env == nullptr || schema->format == nullptr) return;
+    if (strcmp("+s", schema->format) != 0 || schema->dictionary != nullptr) return;
+    if (schema->n_children > 0 && schema->children == nullptr) return;
+    if ((int64_t)plan.root->children.size() != schema->n_children) return;
+
+    ERL_NIF_TERM error{};
+    for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+        struct ArrowSchema * child_schema = schema->children[child_i];
+        std::vector<ERL_NIF_TERM> childrens;
+        ERL_NIF_TERM child_type;
+        ERL_NIF_TERM child_metadata;
+        if (arrow_schema_to_nif_term(plan.env, child_schema, nullptr, 1, childrens, child_type, child_metadata, error) != 0) {
+            return;
+        }
+        plan.root->children[child_i].column_template = make_adbc_column(plan.env, child_schema, child_type, child_metadata);
+    }
+    plan.has_column_templates = true;
+}
+
+/// Returns an estimate of the number of bytes referenced by `array`
+///
+/// Only the validity bitmap, the offsets and the values of binary and
+/// string arrays and the fixed-width values are counted, which is enough
+/// to decide when a batch is large enough to be handed to Elixir.
+static int64_t arrow_array_estimate_bytes(const struct ArrowSchema * schema, const struct ArrowArray * array) {
+    if (schema == nullptr || array == nullptr || schema->format == nullptr) {
+        return 0;
+    }
+
+    int64_t length = array->length;
+    int64_t bytes = 0;
+    if (array->n_buffers > 0 && array->buffers[0] != nullptr) {
+        bytes += (length + 7) / 8;
+    }
+
+    const char * format = schema->format;
+    size_t format_len = strlen(format);
+    if (format_len == 1 && (format[0] == 'u' || format[0] == 'z') && array->n_buffers == 3 && array->buffers[1] != nullptr) {
+        auto offsets = (const int32_t *)array->buffers[1];
+        bytes += (length + 1) * sizeof(int32_t);
+        bytes += offsets[array->offset + length] - offsets[array->offset];
+    } else if (format_len == 1 && (format[0] == 'U' || format[0] == 'Z') && array->n_buffers == 3 && array->buffers[1] != nullptr) {
+        auto offsets = (const int64_t *)array->buffers[1];
+        bytes += (length + 1) * sizeof(int64_t);
+        bytes += offsets[array->offset + length] - offsets[array->offset];
+    } else if (format_len == 2 && format[0] == 'v' && (format[1] == 'u' || format[1] == 'z') && array->n_buffers >= 3) {
+        // 16 bytes per view, plus the variadic data buffers whose sizes are in the last buffer
+        bytes += length * 16;
+        auto variadic_sizes = (const int64_t *)array->buffers[array->n_buffers - 1];
+        for (int64_t buffer_i = 0; variadic_sizes != nullptr && buffer_i < array->n_buffers - 3; buffer_i++) {
+            bytes += variadic_sizes[buffer_i];
+        }
+    } else if (format_len == 1 && format[0] == 'b') {
+        bytes += (length + 7) / 8;
+    } else if (format_len > 2 && format[0] == 'w' && format[1] == ':') {
+        bytes += length * (int64_t)atoi(format + 2);
+    } else if (array->n_buffers >= 2) {
+        // fixed-width values, or the offsets of nested types
+        bytes += length * 8;
+    }
+
+    for (int64_t child_i = 0; child_i < array->n_children && child_i < schema->n_children; child_i++) {
+        bytes += arrow_array_estimate_bytes(schema->children[child_i], array->children[child_i]);
+    }
+    return bytes;
+}
+
+/// Moves the columns of `array` into records and appends the reference
+/// of each record to the list of references of its column in `refs`
+/// @return 0 if success, 1 if failed
+static int arrow_array_to_column_refs_from_plan(ErlNifEnv *env, void * plan_resource, struct ArrowArray * array, std::vector<std::vector<ERL_NIF_TERM>> &refs, ERL_NIF_TERM &error) {
+    auto plan = (NifRes<struct AdbcDecoderPlan> *)plan_resource;
+    struct ArrowSchema * schema = &plan->val.schema;
+    if (array->n_children != schema->n_children) {
+        error = erlang::nif::error(env, "invalid ArrowArray, array->n_children != schema->n_children");
+        return 1;
+    }
+    if (array->n_children > 0 && array->children == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowArray, array->children == nullptr while array->n_children > 0");
+        return 1;
+    }
+
+    refs.resize(schema->n_children);
+    for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+        ERL_NIF_TERM data_ref;
+        if (arrow_array_to_stream_record(env, schema->children[child_i], array->children[child_i], plan_resource, child_i, data_ref, error) != 0) {
+            return 1;
+        }
+        refs[child_i].push_back(data_ref);
+    }
+    return 0;
+}
+
+/// Returns the list of `%Adbc.Column{}` of the stream, copied from the
+/// templates in the decoder plan, with `data` set to the references in `refs`
+static ERL_NIF_TERM arrow_columns_from_plan(ErlNifEnv *env, void * plan_resource, const std::vector<std::vector<ERL_NIF_TERM>> &refs) {
+    auto plan = (NifRes<struct AdbcDecoderPlan> *)plan_resource;
+    std::vector<ERL_NIF_TERM> children(refs.size());
+    for (size_t child_i = 0; child_i < refs.size(); child_i++) {
+        ERL_NIF_TERM column = enif_make_copy(env, plan->val.root->children[child_i].column_template);
+        ERL_NIF_TERM data = enif_make_list_from_array(env, refs[child_i].data(), (unsigned)refs[child_i].size());
+        enif_make_map_update(env, column, kAtomDataKey, data, &children[child_i]);
+    }
+    return enif_make_list_from_array(env, children.data(), (unsigned)children.size());
+}
+
 #endif  // ADBC_ARROW_ARRAY_HPP
@@ -0,0 +1,169 @@
+#ifndef ADBC_BITMAP_HPP
+#define ADBC_BITMAP_HPP
+#pragma once
+
+#include <cstdint>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// @return the number of bits set in `word`
+static inline int adbc_popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/// @return the number of trailing zero bits in `word`, which must not be 0
+static inline int adbc_ctz64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    int n = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/// Loads `nbits` (at most 64) bits of an LSB-first bitmap starting at bit
+/// `bit_offset`, bit `bit_offset` becomes the least significant bit of the
+/// result and the bits past `nbits` are 0
+static inline uint64_t adbc_bitmap_load(const uint8_t * bitmap, int64_t bit_offset, int nbits) {
+    const uint8_t * bytes = bitmap + bit_offset / 8;
+    int shift = (int)(bit_offset % 8);
+    int nbytes = (shift + nbits + 7) / 8;
+
+    // assembled byte by byte so that it's correct on any endianness,
+    // compilers turn it into a single load on little-endian targets
+    uint64_t word = 0;
+    for (int i = 0; i < nbytes && i < 8; i++) {
+        word |= (uint64_t)bytes[i] << (8 * i);
+    }
+    word >>= shift;
+    if (nbytes > 8) {
+        word |= (uint64_t)bytes[8] << (64 - shift);
+    }
+    if (nbits < 64) {
+        word &= ((uint64_t)1 << nbits) - 1;
+    }
+    return word;
+}
+
+/// Sets the bits of `bitmap` starting at bit `bit_offset` that are set in
+/// the lowest `nbits` (at most 64) bits of `word`, the others are left as they are
+static inline void adbc_bitmap_or(uint8_t * bitmap, int64_t bit_offset, uint64_t word, int nbits) {
+    uint8_t * bytes = bitmap + bit_offset / 8;
+    int shift = (int)(bit_offset % 8);
+    int nbytes = (shift + nbits + 7) / 8;
+    if (nbits < 64) {
+        word &= ((uint64_t)1 << nbits) - 1;
+    }
+    uint64_t shifted = word << shift;
+    for (int i = 0; i < nbytes && i < 8; i++) {
+        bytes[i] |= (uint8_t)(shifted >> (8 * i));
+    }
+    if (nbytes > 8) {
+        bytes[8] |= (uint8_t)(word >> (64 - shift));
+    }
+}
+
+/// @return the number of bits set in `count` bits of `bitmap` starting at `offset`
+static inline int64_t adbc_bitmap_count_set(const uint8_t * bitmap, int64_t offset, int64_t count) {
+    int64_t n = 0;
+    for (int64_t i = offset; i < offset + count; i += 64) {
+        int nbits = offset + count - i < 64 ? (int)(offset + count - i) : 64;
+        n += adbc_popcount64(adbc_bitmap_load(bitmap, i, nbits));
+    }
+    return n;
+}
+
+/// Returns the validity bitmap of `array`, or nullptr if none of its
+/// `count` values starting at `offset` is null, in which case the bitmap
+/// does not need to be read.
+///
+/// When the null count is unknown (-1), only that window of the bitmap is
+/// counted, so that slices without nulls still take the fast path.
+static inline const uint8_t * adbc_validity_bitmap(const struct ArrowArray * array, int64_t offset, int64_t count) {
+    if (array->null_count == 0 || array->n_buffers == 0 || array->buffers[0] == nullptr) {
+        return nullptr;
+    }
+    const uint8_t * bitmap = (const uint8_t *)array->buffers[0];
+    if (array->null_count < 0) {
+        int64_t end = offset + count < array->length ? offset + count : array->length;
+        if (offset >= end || adbc_bitmap_count_set(bitmap, offset, end - offset) == end - offset) {
+            return nullptr;
+        }
+    }
+    return bitmap;
+}
+
+/// Splits `count` bits of `bitmap` starting at `offset` into runs of
+/// set and unset bits, and calls `on_set(begin, end)` or
+/// `on_unset(begin, end)` for each of them, in order.
+///
+/// The bitmap is read 64 bits at a time, whole words of set or unset bits
+/// become one run each, and mixed words are split with ctz.
+template <typename S, typename U> static void adbc_bitmap_visit_runs(const uint8_t * bitmap, int64_t offset, int64_t count, const S& on_set, const U& on_unset) {
+    int64_t end = offset + count;
+    for (int64_t i = offset; i < end; i += 64) {
+        int nbits = end - i < 64 ? (int)(end - i) : 64;
+        uint64_t word = adbc_bitmap_load(bitmap, i, nbits);
+        int n_set = adbc_popcount64(word);
+        if (n_set == nbits) {
+            on_set(i, i + nbits);
+            continue;
+        }
+        if (n_set == 0) {
+            on_unset(i, i + nbits);
+            continue;
+        }
+
+        int pos = 0;
+        while (pos < nbits) {
+            uint64_t rest = word >> pos;
+            int run;
+            if (rest & 1) {
+                // the bits past `nbits` are 0, so `~rest` is never 0 here
+                run = adbc_ctz64(~rest);
+                if (run > nbits - pos) run = nbits - pos;
+                on_set(i + pos, i + pos + run);
+            } else {
+                run = rest == 0 ? nbits - pos : adbc_ctz64(rest);
+                if (run > nbits - pos) run = nbits - pos;
+                on_unset(i + pos, i + pos + run);
+            }
+            pos += run;
+        }
+    }
+}
+
+/// Expands `count` bits of `bitmap` starting at `offset` into `out`,
+/// `out[i]` is `terms[1]` if bit `offset + i` is set, `terms[0]` otherwise
+static inline void adbc_bitmap_unpack(const uint8_t * bitmap, int64_t offset, int64_t count, const ERL_NIF_TERM terms[2], ERL_NIF_TERM * out) {
+    for (int64_t i = 0; i < count; i += 64) {
+        int nbits = count - i < 64 ? (int)(count - i) : 64;
+        uint64_t word = adbc_bitmap_load(bitmap, offset + i, nbits);
+        // branch-free, so that it can be vectorized
+        for (int bit = 0; bit < nbits; bit++) {
+            out[i + bit] = terms[(word >> bit) & 1];
+        }
+    }
+}
+
+#endif  // ADBC_BITMAP_HPP
@@ -0,0 +1,329 @@
+#ifndef ADBC_CALENDAR_HPP
+#define ADBC_CALENDAR_HPP
+#pragma once
+
+#include <cstdint>
+#include <erl_nif.h>
+#include "adbc_consts.h"
+
+static inline int64_t adbc_floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+static inline int64_t adbc_floor_mod(int64_t a, int64_t b) {
+    return a - adbc_floor_div(a, b) * b;
+}
+
+/// Converts the number of days since 1970-01-01 to a date
+/// in the proleptic Gregorian calendar.
+///
+/// Only uses integer arithmetic, so it's thread-safe and valid
+/// for dates outside of the range of `time_t`.
+static inline void adbc_civil_from_days(int64_t days, int64_t &year, unsigned &month, unsigned &day) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = (unsigned)(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = (int64_t)yoe + era * 400 + (month <= 2);
+}
+
+/// Converts a date in the proleptic Gregorian calendar to the number
+/// of days since 1970-01-01, the inverse of `adbc_civil_from_days`
+static inline int64_t adbc_days_from_civil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = (unsigned)(year - era * 400);
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+/// Splits a value in the given unit (`s`, `m`, `u` or `n`) into
+/// seconds and the microseconds within that second
+static inline void adbc_calendar_split(int64_t val, char unit, int64_t &seconds, int64_t &us) {
+    switch (unit) {
+        case 'm':
+            seconds = adbc_floor_div(val, 1000);
+            us = adbc_floor_mod(val, 1000) * 1000;
+            break;
+        case 'u':
+            seconds = adbc_floor_div(val, 1000000);
+            us = adbc_floor_mod(val, 1000000);
+            break;
+        case 'n':
+            seconds = adbc_floor_div(val, 1000000000);
+            us = adbc_floor_mod(val, 1000000000) / 1000;
+            break;
+        default:
+            seconds = val;
+            us = 0;
+            break;
+    }
+}
+
+// The keys of the maps below are listed in term order,
+// which is the order in which maps keep them
+static inline ERL_NIF_TERM adbc_calendar_make_map(ErlNifEnv *env, ERL_NIF_TERM * keys, ERL_NIF_TERM * values, size_t count) {
+    ERL_NIF_TERM map;
+    enif_make_map_from_arrays(env, keys, values, count, &map);
+    return map;
+}
+
+/// Returns a `%Date{}` for the number of days since 1970-01-01
+static ERL_NIF_TERM adbc_calendar_date(ErlNifEnv *env, int64_t days) {
+    int64_t year;
+    unsigned month, day;
+    adbc_civil_from_days(days, year, month, day);
+
+    ERL_NIF_TERM keys[] = {
+        kAtomStructKey,
+        kAtomCalendarKey,
+        kAtomDayKey,
+        kAtomMonthKey,
+        kAtomYearKey,
+    };
+    ERL_NIF_TERM values[] = {
+        kAtomDateModule,
+        kAtomCalendarISO,
+        enif_make_uint(env, day),
+        enif_make_uint(env, month),
+        enif_make_int64(env, year),
+    };
+    return adbc_calendar_make_map(env, keys, values, 5);
+}
+
+/// Returns a `%Time{}` for the given seconds and microseconds since midnight
+static ERL_NIF_TERM adbc_calendar_time(ErlNifEnv *env, int64_t seconds, int64_t us, int us_precision) {
+    int64_t seconds_of_day = adbc_floor_mod(seconds, 86400);
+    ERL_NIF_TERM keys[] = {
+        kAtomStructKey,
+        kAtomCalendarKey,
+        kAtomHourKey,
+        kAtomMicrosecondKey,
+        kAtomMinuteKey,
+        kAtomSecondKey,
+    };
+    ERL_NIF_TERM values[] = {
+        kAtomTimeModule,
+        kAtomCalendarISO,
+        enif_make_int(env, (int)(seconds_of_day / 3600)),
+        enif_make_tuple2(env, enif_make_int(env, (int)us), enif_make_int(env, us_precision)),
+        enif_make_int(env, (int)(seconds_of_day / 60 % 60)),
+        enif_make_int(env, (int)(seconds_of_day % 60)),
+    };
+    return adbc_calendar_make_map(env, keys, values, 6);
+}
+
+/// Returns a `%NaiveDateTime{}` for the given seconds since the Unix epoch
+/// and microseconds within that second
+static ERL_NIF_TERM adbc_calendar_naive_datetime(ErlNifEnv *env, int64_t seconds, int64_t us, int us_precision) {
+    int64_t year;
+    unsigned month, day;
+    adbc_civil_from_days(adbc_floor_div(seconds, 86400), year, month, day);
+    int64_t seconds_of_day = adbc_floor_mod(seconds, 86400);
+
+    ERL_NIF_TERM keys[] = {
+        kAtomStructKey,
+        kAtomCalendarKey,
+        kAtomDayKey,
+        kAtomHourKey,
+        kAtomMicrosecondKey,
+        kAtomMinuteKey,
+        kAtomMonthKey,
+        kAtomSecondKey,
+        kAtomYearKey,
+    };
+    ERL_NIF_TERM values[] = {
+        kAtomNaiveDateTimeModule,
+        kAtomCalendarISO,
+        enif_make_uint(env, day),
+        enif_make_int(env, (int)(seconds_of_day / 3600)),
+        enif_make_tuple2(env, enif_make_int(env, (int)us), enif_make_int(env, us_precision)),
+        enif_make_int(env, (int)(seconds_of_day / 60 % 60)),
+        enif_make_uint(env, month),
+        enif_make_int(env, (int)(seconds_of_day % 60)),
+        enif_make_int64(env, year),
+    };
+    return adbc_calendar_make_map(env, keys, values, 9);
+}
+
+/// The fields of a `%Date{}`, `%Time{}` or `%NaiveDateTime{}`
+struct AdbcCalendarFields {
+    enum Field : unsigned {
+        kStruct = 1 << 0,
+        kCalendar = 1 << 1,
+        kYear = 1 << 2,
+        kMonth = 1 << 3,
+        kDay = 1 << 4,
+        kHour = 1 << 5,
+        kMinute = 1 << 6,
+        kSecond = 1 << 7,
+        kMicrosecond = 1 << 8,
+    };
+
+    // the fields that were found
+    unsigned found = 0;
+    ERL_NIF_TERM struct_name, calendar, microsecond;
+    int64_t year;
+    unsigned month, day, hour, minute, second;
+};
+
+/// Reads the fields of the calendar struct `map` in one pass over its keys,
+/// instead of looking them up one by one
+///
+/// @return 0 on success, `kErrorBufferGetMapValue` if a field that was
+/// found has a value of the wrong type
+static int adbc_calendar_get_fields(ErlNifEnv *env, ERL_NIF_TERM map, AdbcCalendarFields &fields) {
+    ErlNifMapIterator iter;
+    if (!enif_map_iterator_create(env, map, &iter, ERL_NIF_MAP_ITERATOR_FIRST)) {
+        return kErrorBufferGetMapValue;
+    }
+
+    int ret = 0;
+    ERL_NIF_TERM key, value;
+    while (ret == 0 && enif_map_iterator_get_pair(env, &iter, &key, &value)) {
+        ErlNifSInt64 year;
+        unsigned number;
+        if (enif_is_identical(key, kAtomStructKey)) {
+            fields.struct_name = value;
+            fields.found |= AdbcCalendarFields::kStruct;
+        } else if (enif_is_identical(key, kAtomCalendarKey)) {
+            fields.calendar = value;
+            fields.found |= AdbcCalendarFields::kCalendar;
+        } else if (enif_is_identical(key, kAtomMicrosecondKey)) {
+            fields.microsecond = value;
+            fields.found |= AdbcCalendarFields::kMicrosecond;
+        } else if (enif_is_identical(key, kAtomYearKey)) {
+            if (enif_get_int64(env, value, &year)) {
+                fields.year = year;
+                fields.found |= AdbcCalendarFields::kYear;
+            } else {
+                ret = kErrorBufferGetMapValue;
+            }
+        } else {
+            unsigned * field = nullptr;
+            unsigned flag = 0;
+            if (enif_is_identical(key, kAtomMonthKey)) {
+                field = &fields.month;
+                flag = AdbcCalendarFields::kMonth;
+            } else if (enif_is_identical(key, kAtomDayKey)) {
+                field = &fields.day;
+                flag = AdbcCalendarFields::kDay;
+            } else if (enif_is_identical(key, kAtomHourKey)) {
+                field = &fields.hour;
+                flag = AdbcCalendarFields::kHour;
+            } else if (enif_is_identical(key, kAtomMinuteKey)) {
+                field = &fields.minute;
+                flag = AdbcCalendarFields::kMinute;
+            } else if (enif_is_identical(key, kAtomSecondKey)) {
+                field = &fields.second;
+                flag = AdbcCalendarFields::kSecond;
+            }
+            if (field != nullptr) {
+                if (enif_get_uint(env, value, &number)) {
+                    *field = number;
+                    fields.found |= flag;
+                } else {
+                    ret = kErrorBufferGetMapValue;
+                }
+            }
+        }
+        enif_map_iterator_next(env, &iter);
+    }
+    enif_map_iterator_destroy(env, &iter);
+    return ret;
+}
+
+/// Reads the fields of `map` and checks that it is a `module` struct in the
+/// ISO calendar that has all the fields in `required`
+///
+/// @return 0 on success, otherwise the error of the column
+static int adbc_calendar_get_struct(ErlNifEnv *env, ERL_NIF_TERM map, ERL_NIF_TERM module, unsigned required, AdbcCalendarFields &fields) {
+    int ret = adbc_calendar_get_fields(env, map, fields);
+    if (ret != 0) {
+        return ret;
+    }
+    if (!(fields.found & AdbcCalendarFields::kStruct)) {
+        return kErrorBufferGetMapValue;
+    }
+    if (!enif_is_identical(fields.struct_name, module)) {
+        return kErrorBufferWrongStruct;
+    }
+    if (!(fields.found & AdbcCalendarFields::kCalendar)) {
+        return kErrorBufferGetMapValue;
+    }
+    if (!enif_is_identical(fields.calendar, kAtomCalendarISO)) {
+        return kErrorExpectedCalendarISO;
+    }
+    if ((fields.found & required) != required) {
+        return kErrorBufferGetMapValue;
+    }
+    return 0;
+}
+
+/// Gets the microseconds of a `{microseconds, precision}` tuple
+static int adbc_calendar_get_microseconds(ErlNifEnv *env, ERL_NIF_TERM microsecond, int64_t &us) {
+    const ERL_NIF_TERM *us_tuple = nullptr;
+    int us_arity;
+    ErlNifSInt64 value;
+    int us_precision;
+    if (!enif_get_tuple(env, microsecond, &us_arity, &us_tuple) || us_arity != 2) {
+        return kErrorBufferGetMapValue;
+    }
+    if (!enif_get_int64(env, us_tuple[0], &value) || !enif_get_int(env, us_tuple[1], &us_precision)) {
+        return kErrorBufferGetMapValue;
+    }
+    us = value;
+    return 0;
+}
+
+/// Gets the number of days since 1970-01-01 of a `%Date{}`
+///
+/// Unlike `mktime`, this neither depends on the local time zone nor is
+/// limited to the range of `time_t`.
+static int adbc_calendar_get_date(ErlNifEnv *env, ERL_NIF_TERM map, int64_t &days) {
+    AdbcCalendarFields fields;
+    const unsigned required = AdbcCalendarFields::kYear | AdbcCalendarFields::kMonth | AdbcCalendarFields::kDay;
+    int ret = adbc_calendar_get_struct(env, map, kAtomDateModule, required, fields);
+    if (ret != 0) {
+        return ret;
+    }
+    days = adbc_days_from_civil(fields.year, fields.month, fields.day);
+    return 0;
+}
+
+/// Gets the seconds since midnight and the microseconds within that
+/// second of a `%Time{}`
+static int adbc_calendar_get_time(ErlNifEnv *env, ERL_NIF_TERM map, int64_t &seconds, int64_t &us) {
+    AdbcCalendarFields fields;
+    const unsigned required = AdbcCalendarFields::kHour | AdbcCalendarFields::kMinute | AdbcCalendarFields::kSecond | AdbcCalendarFields::kMicrosecond;
+    int ret = adbc_calendar_get_struct(env, map, kAtomTimeModule, required, fields);
+    if (ret != 0) {
+        return ret;
+    }
+    seconds = (int64_t)fields.hour * 3600 + (int64_t)fields.minute * 60 + (int64_t)fields.second;
+    return adbc_calendar_get_microseconds(env, fields.microsecond, us);
+}
+
+/// Gets the seconds since the Unix epoch and the microseconds within that
+/// second of a `%NaiveDateTime{}`
+static int adbc_calendar_get_naive_datetime(ErlNifEnv *env, ERL_NIF_TERM map, int64_t &seconds, int64_t &us) {
+    AdbcCalendarFields fields;
+    const unsigned required = AdbcCalendarFields::kYear | AdbcCalendarFields::kMonth | AdbcCalendarFields::kDay
+        | AdbcCalendarFields::kHour | AdbcCalendarFields::kMinute | AdbcCalendarFields::kSecond | AdbcCalendarFields::kMicrosecond;
+    int ret = adbc_calendar_get_struct(env, map, kAtomNaiveDateTimeModule, required, fields);
+    if (ret != 0) {
+        return ret;
+    }
+    seconds = adbc_days_from_civil(fields.year, fields.month, fields.day) * 86400
+        + (int64_t)fields.hour * 3600 + (int64_t)fields.minute * 60 + (int64_t)fields.second;
+    return adbc_calendar_get_microseconds(env, fields.microsecond, us);
+}
+
+#endif  // ADBC_CALENDAR_HPP
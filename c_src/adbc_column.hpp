@@ -1,16 +1,19 @@
 #ifndef ADBC_COLUMN_HPP
 #pragma once
 
-#include <time.h>
 #include <cstdbool>
 #include <cstdint>
-#include <functional>
 #include <type_traits>
 #include <optional>
 #include <arrow-adbc/adbc.h>
 #include <erl_nif.h>
 #include <nanoarrow/nanoarrow.hpp>
+#include "adbc_array_builder.hpp"
+#include "adbc_arrow_array_packed.hpp"
+#include "adbc_bitmap.hpp"
+#include "adbc_calendar.hpp"
 #include "adbc_consts.h"
+#include "adbc_decimal.hpp"
 #include "adbc_half_float.hpp"
 #include "nif_utils.hpp"
 
@@ -178,19 +181,19 @@ ERL_NIF_TERM make_adbc_column(ErlNifEnv *env, struct ArrowSchema * schema, struc
 
 template <typename Integer, typename std::enable_if<
         std::is_integral<Integer>{} && std::is_signed<Integer>{}, bool>::type = true>
-int get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, Integer val)> &callback) {
+int get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<Integer> &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int64_t val;
         if (!erlang::nif::get(env, head, &val)) {
             if (nullable && enif_is_identical(head, kAtomNil)) {
-                NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+                NANOARROW_RETURN_NOT_OK(appender.append_null());
             } else {
                 return 1;
             }
         } else {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, (Integer)val));
+            appender.append((Integer)val);
         }
     }
     return 0;
@@ -198,26 +201,26 @@ int get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Ar
 
 template <typename Integer, typename std::enable_if<
         std::is_integral<Integer>{} && !std::is_signed<Integer>{}, bool>::type = true>
-int get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, Integer val)> &callback) {
+int get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<Integer> &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         uint64_t val;
         if (!erlang::nif::get(env, head, &val)) {
             if (nullable && enif_is_identical(head, kAtomNil)) {
-                NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+                NANOARROW_RETURN_NOT_OK(appender.append_null());
             } else {
                 return 1;
             }
         } else {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, (Integer)val));
+            appender.append((Integer)val);
         }
     }
     return 0;
 }
 
 template <typename T>
-int do_get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, bool skip_init, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, bool skip_init, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array;
     if (!skip_init) {
@@ -231,7 +234,9 @@ int do_get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, bool s
         write_array = array_out;
     }
 
-    int ret = get_list_integer<T>(env, list, nullable, write_array, ArrowArrayAppendInt);
+    AdbcFixedWidthAppender<T> appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+    int ret = get_list_integer<T>(env, list, nullable, appender);
     if (ret == 0) {
         if (!skip_init) {
             NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
@@ -241,61 +246,110 @@ int do_get_list_integer(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, bool s
     return ret;
 }
 
-int get_list_float(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, double val)> &callback) {
+template <typename Float>
+int get_list_float(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<Float> &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         double val;
         if (!erlang::nif::get(env, head, &val)) {
             if (nullable && enif_is_identical(head, kAtomNil)) {
-                NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+                NANOARROW_RETURN_NOT_OK(appender.append_null());
             } else if (enif_is_identical(head, kAtomInfinity)) {
-                NANOARROW_RETURN_NOT_OK(callback(write_array, std::numeric_limits<double>::infinity()));
+                appender.append(std::numeric_limits<Float>::infinity());
             } else if (enif_is_identical(head, kAtomNegInfinity)) {
-                NANOARROW_RETURN_NOT_OK(callback(write_array, -std::numeric_limits<double>::infinity()));
+                appender.append(-std::numeric_limits<Float>::infinity());
             } else if (enif_is_identical(head, kAtomNaN)) {
-                NANOARROW_RETURN_NOT_OK(callback(write_array, std::numeric_limits<double>::quiet_NaN()));
+                appender.append(std::numeric_limits<Float>::quiet_NaN());
             } else {
                 return 1;
             }
         } else {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            appender.append((Float)val);
         }
     }
     return 0;
 }
 
-int do_get_list_half_float(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_half_float(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
+    // the values are collected first so that they can be converted
+    // to half precision in one batch, see `float_to_float16_batch`
+    std::vector<float> floats;
+    std::vector<uint8_t> is_valid;
+    floats.reserve(n_items);
+    is_valid.reserve(n_items);
+    int64_t null_count = 0;
+
+    ERL_NIF_TERM head, tail;
+    tail = list;
+    while (enif_get_list_cell(env, tail, &head, &tail)) {
+        double val;
+        if (erlang::nif::get(env, head, &val)) {
+            floats.push_back((float)val);
+        } else if (nullable && enif_is_identical(head, kAtomNil)) {
+            floats.push_back(0);
+            is_valid.resize(floats.size() - 1, 1);
+            is_valid.push_back(0);
+            null_count++;
+            continue;
+        } else if (enif_is_identical(head, kAtomInfinity)) {
+            floats.push_back(std::numeric_limits<float>::infinity());
+        } else if (enif_is_identical(head, kAtomNegInfinity)) {
+            floats.push_back(-std::numeric_limits<float>::infinity());
+        } else if (enif_is_identical(head, kAtomNaN)) {
+            floats.push_back(std::numeric_limits<float>::quiet_NaN());
+        } else {
+            return 1;
+        }
+        if (null_count > 0) {
+            is_valid.push_back(1);
+        }
+    }
+
+    std::vector<uint16_t> halfs(floats.size());
+    float_to_float16_batch(floats.data(), halfs.data(), (int64_t)floats.size());
+
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
-
-    struct ArrowArrayPrivateData* private_data = (struct ArrowArrayPrivateData*)write_array->private_data;
-    auto storage_type = private_data->storage_type;
-    private_data->storage_type = NANOARROW_TYPE_UINT16;
-
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_float(env, list, nullable, write_array, [](struct ArrowArray* arr, double val) -> int {
-        return ArrowArrayAppendUInt(arr, float_to_float16(val));
-    });
-    if (ret == 0) {
-        private_data->storage_type = storage_type;
-        NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
-        ArrowArrayMove(tmp.get(), array_out);
+
+    // the buffers are filled directly, there's no append function for half floats
+    NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(ArrowArrayBuffer(write_array, 1), halfs.data(), (int64_t)(halfs.size() * sizeof(uint16_t))));
+    if (null_count > 0) {
+        struct ArrowBitmap* validity = ArrowArrayValidityBitmap(write_array);
+        NANOARROW_RETURN_NOT_OK(ArrowBitmapReserve(validity, (int64_t)is_valid.size()));
+        for (uint8_t valid : is_valid) {
+            ArrowBitmapAppendUnsafe(validity, valid, 1);
+        }
     }
-    return ret;
+    write_array->length = (int64_t)halfs.size();
+    write_array->null_count = null_count;
+
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
+    ArrowArrayMove(tmp.get(), array_out);
+    return 0;
 }
 
-int do_get_list_float(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_float(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_float(env, list, nullable, write_array, ArrowArrayAppendDouble);
+    int ret;
+    if (nanoarrow_type == NANOARROW_TYPE_FLOAT) {
+        AdbcFixedWidthAppender<float> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_float(env, list, nullable, appender);
+    } else {
+        AdbcFixedWidthAppender<double> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_float(env, list, nullable, appender);
+    }
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -303,30 +357,19 @@ int do_get_list_float(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowTyp
     return ret;
 }
 
-int get_list_decimal(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, ArrowType nanoarrow_type, int32_t bitwidth, int32_t precision, int32_t scale, const std::function<int(struct ArrowArray*, const struct ArrowDecimal*)> &callback) {
+int get_list_decimal(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedSizeBinaryAppender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
-        struct ArrowDecimal val{};
-        ArrowDecimalInit(&val, bitwidth, precision, scale);
         ErlNifBinary bytes;
         if (enif_inspect_iolist_as_binary(env, head, &bytes)) {
-            if (nanoarrow_type == NANOARROW_TYPE_DECIMAL128) {
-                if (bytes.size != 16) {
-                    return 1;
-                }
-                ArrowDecimalSetBytes(&val, (const uint8_t *)bytes.data);
-            } else if (nanoarrow_type == NANOARROW_TYPE_DECIMAL256) {
-                if (bytes.size != 32) {
-                    return 1;
-                }
-                ArrowDecimalSetBytes(&val, (const uint8_t *)bytes.data);
-            } else {
+            // the bytes are already in the little-endian layout of the decimal
+            if ((int64_t)bytes.size != appender.width) {
                 return 1;
             }
-            NANOARROW_RETURN_NOT_OK(callback(write_array, &val));
+            appender.append(bytes.data);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -334,14 +377,25 @@ int get_list_decimal(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Ar
     return 0;
 }
 
-int do_get_list_decimal(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, int32_t bitwidth, int32_t precision, int32_t scale, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_decimal(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, int32_t bitwidth, int32_t precision, int32_t scale, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDecimal(schema_out, nanoarrow_type, precision, scale));
 
+    int64_t width;
+    if (nanoarrow_type == NANOARROW_TYPE_DECIMAL128) {
+        width = 16;
+    } else if (nanoarrow_type == NANOARROW_TYPE_DECIMAL256) {
+        width = 32;
+    } else {
+        return 1;
+    }
+
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_decimal(env, list, nullable, write_array, nanoarrow_type, bitwidth, precision, scale, ArrowArrayAppendDecimal);
+    AdbcFixedSizeBinaryAppender appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, width, n_items));
+    int ret = get_list_decimal(env, list, nullable, appender);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -405,18 +459,16 @@ failed:
     return ret;
 }
 
-int get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray * write_array, const std::function<int(struct ArrowArray *, struct ArrowStringView val)> &callback) {
+template <typename Appender>
+int get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, Appender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         ErlNifBinary bytes;
-        struct ArrowStringView val{};
         if (enif_inspect_iolist_as_binary(env, head, &bytes)) {
-            val.data = (const char *)bytes.data;
-            val.size_bytes = static_cast<int64_t>(bytes.size);
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            NANOARROW_RETURN_NOT_OK(appender.append(bytes.data, static_cast<int64_t>(bytes.size)));
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -424,14 +476,57 @@ int get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Arr
     return 0;
 }
 
-int do_get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int get_list_string_view(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcBinaryViewAppender &appender) {
+    ERL_NIF_TERM head, tail;
+    tail = list;
+    while (enif_get_list_cell(env, tail, &head, &tail)) {
+        if (nullable && enif_is_identical(head, kAtomNil)) {
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
+        } else {
+            NANOARROW_RETURN_NOT_OK(appender.append(env, head));
+        }
+    }
+    return 0;
+}
+
+/// @return the total size of the values in `list` that are binaries, iolists are not counted
+int64_t get_list_binary_size(ErlNifEnv *env, ERL_NIF_TERM list) {
+    int64_t nbytes = 0;
+    ERL_NIF_TERM head, tail;
+    tail = list;
+    while (enif_get_list_cell(env, tail, &head, &tail)) {
+        ErlNifBinary bytes;
+        if (enif_inspect_binary(env, head, &bytes)) {
+            nbytes += (int64_t)bytes.size;
+        }
+    }
+    return nbytes;
+}
+
+int do_get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromType(write_array, nanoarrow_type));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_string(env, list, nullable, write_array, ArrowArrayAppendString);
+    int ret;
+    if (nanoarrow_type == NANOARROW_TYPE_STRING || nanoarrow_type == NANOARROW_TYPE_BINARY) {
+        AdbcVarBinaryAppender<int32_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        NANOARROW_RETURN_NOT_OK(appender.reserve_data(get_list_binary_size(env, list)));
+        ret = get_list_string(env, list, nullable, appender);
+    } else if (nanoarrow_type == NANOARROW_TYPE_LARGE_STRING || nanoarrow_type == NANOARROW_TYPE_LARGE_BINARY) {
+        AdbcVarBinaryAppender<int64_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        NANOARROW_RETURN_NOT_OK(appender.reserve_data(get_list_binary_size(env, list)));
+        ret = get_list_string(env, list, nullable, appender);
+    } else {
+        // long values are referenced where they are instead of copied
+        AdbcBinaryViewAppender appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_string_view(env, list, nullable, appender);
+    }
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -439,16 +534,16 @@ int do_get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowTy
     return ret;
 }
 
-int get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, bool val)> &callback) {
+int get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<bool> &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         if (enif_is_identical(head, kAtomTrue)) {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, true));
+            appender.append(true);
         } else if (enif_is_identical(head, kAtomFalse)) {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, false));
+            appender.append(false);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -456,14 +551,16 @@ int get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Ar
     return 0;
 }
 
-int do_get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_boolean(env, list, nullable, write_array, ArrowArrayAppendInt);
+    AdbcFixedWidthAppender<bool> appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+    int ret = get_list_boolean(env, list, nullable, appender);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -471,18 +568,18 @@ int do_get_list_boolean(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowT
     return ret;
 }
 
-int get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, struct ArrowBufferView val)> &callback) {
+int get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedSizeBinaryAppender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         ErlNifBinary bytes;
-        struct ArrowBufferView val{};
         if (enif_inspect_iolist_as_binary(env, head, &bytes)) {
-            val.data.data = bytes.data;
-            val.size_bytes = static_cast<int64_t>(bytes.size);
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            if ((int64_t)bytes.size != appender.width) {
+                return EINVAL;
+            }
+            appender.append(bytes.data);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -490,14 +587,16 @@ int get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable,
     return 0;
 }
 
-int do_get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, int32_t fixed_size, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, int32_t fixed_size, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeFixedSize(schema_out, nanoarrow_type, fixed_size));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_fixed_size_binary(env, list, nullable, write_array, ArrowArrayAppendBytes);
+    AdbcFixedSizeBinaryAppender appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, fixed_size, n_items));
+    int ret = get_list_fixed_size_binary(env, list, nullable, appender);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -505,68 +604,27 @@ int do_get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullab
     return ret;
 }
 
-int get_utc_offset() {
-    time_t zero = 24 * 60 * 60L;
-    struct tm * timeptr;
-    int gmtime_hours;
-    timeptr = localtime(&zero);
-    gmtime_hours = timeptr->tm_hour;
-    if (timeptr->tm_mday < 2) {
-        gmtime_hours -= 24;
-    }
-    return gmtime_hours;
-}
-
-int get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+template <typename T, typename Normalize>
+int get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<T> &appender, const Normalize &normalize_ex_value) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         if (enif_is_identical(head, kAtomNil)) {
             if (nullable) {
-                NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+                NANOARROW_RETURN_NOT_OK(appender.append_null());
             } else {
                 return 1;
             }
         } else {
             int64_t val;
             if (erlang::nif::get(env, head, &val)) {
-                NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+                NANOARROW_RETURN_NOT_OK(appender.append_checked(val));
             } else if (enif_is_map(env, head)) {
-                ERL_NIF_TERM struct_name_term, calendar_term, year_term, month_term, day_term;
-                if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_is_identical(struct_name_term, kAtomDateModule)) {
-                    return kErrorBufferWrongStruct;
-                }
-
-                if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                    return kErrorExpectedCalendarISO;
-                }
-
-                if (!enif_get_map_value(env, head, kAtomYearKey, &year_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_get_map_value(env, head, kAtomMonthKey, &month_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_get_map_value(env, head, kAtomDayKey, &day_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-
-                tm time{};
-                if (!erlang::nif::get(env, year_term, &time.tm_year) || !erlang::nif::get(env, month_term, &time.tm_mon) || !erlang::nif::get(env, day_term, &time.tm_mday)) {
-                    return kErrorBufferGetMapValue;
+                int ret = adbc_calendar_get_date(env, head, val);
+                if (ret != 0) {
+                    return ret;
                 }
-                time.tm_year -= 1900;
-                time.tm_mon -= 1;
-                // mktime always gives local time
-                // so we need to adjust it to UTC
-                val = mktime(&time) + get_utc_offset() * 3600;
-                NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val)));
+                NANOARROW_RETURN_NOT_OK(appender.append_checked(normalize_ex_value(val)));
             } else {
                 return 1;
             }
@@ -575,25 +633,27 @@ int get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Arrow
     return 0;
 }
 
-int do_get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    std::function<int64_t(int64_t)> normalize_ex_value;
+    int ret;
     if (nanoarrow_type == NANOARROW_TYPE_DATE32) {
-        normalize_ex_value = [](int64_t val) -> int64_t {
-            return val / (24 * 60 * 60);
-        };
+        AdbcFixedWidthAppender<int32_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_date(env, list, nullable, appender, [](int64_t days) -> int64_t {
+            return days;
+        });
     } else {
-        normalize_ex_value = [](int64_t val) -> int64_t {
-            return val * 1000;
-        };
+        AdbcFixedWidthAppender<int64_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_date(env, list, nullable, appender, [](int64_t days) -> int64_t {
+            return days * 24 * 60 * 60 * 1000;
+        });
     }
-
-    int ret = get_list_date(env, list, nullable, write_array, normalize_ex_value, ArrowArrayAppendInt);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -601,62 +661,23 @@ int do_get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType
     return ret;
 }
 
-int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, uint64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+template <typename T, typename Normalize>
+int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<T> &appender, const Normalize &normalize_ex_value) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int64_t val;
         if (erlang::nif::get(env, head, &val)) {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            NANOARROW_RETURN_NOT_OK(appender.append_checked(val));
         } else if (enif_is_map(env, head)) {
-            ERL_NIF_TERM struct_name_term, calendar_term, hour_term, minute_term, second_term, microsecond_term;
-            if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(struct_name_term, kAtomTimeModule)) {
-                return kErrorBufferWrongStruct;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                return kErrorExpectedCalendarISO;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomHourKey, &hour_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMinuteKey, &minute_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomSecondKey, &second_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMicrosecondKey, &microsecond_term)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            tm time{};
-            if (!erlang::nif::get(env, hour_term, &time.tm_hour) || !erlang::nif::get(env, minute_term, &time.tm_min) || !erlang::nif::get(env, second_term, &time.tm_sec)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            const ERL_NIF_TERM *us_tuple = nullptr;
-            int us_arity;
-            uint64_t us;
-            int us_precision;
-            if (!enif_get_tuple(env, microsecond_term, &us_arity, &us_tuple) || us_arity != 2) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!erlang::nif::get(env, us_tuple[0], &us) || !erlang::nif::get(env, us_tuple[1], &us_precision)) {
-                return kErrorBufferGetMapValue;
+            int64_t us;
+            int ret = adbc_calendar_get_time(env, head, val, us);
+            if (ret != 0) {
+                return ret;
             }
-
-            val = time.tm_hour * 3600 + time.tm_min * 60 + time.tm_sec;
-            NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val, us)));
+            NANOARROW_RETURN_NOT_OK(appender.append_checked(normalize_ex_value(val, us)));
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -664,21 +685,30 @@ int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Arrow
     return 0;
 }
 
-int do_get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, uint64_t unit, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, uint64_t unit, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, nanoarrow_type, time_unit, NULL));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    auto normalize_ex_value = [=](int64_t val, uint64_t us) -> int64_t {
+    auto normalize_ex_value = [=](int64_t val, int64_t us) -> int64_t {
         if (time_unit == NANOARROW_TIME_UNIT_SECOND) {
             return val;
         }
         val = (val * 1000000 + us) * 1000 / unit;
         return val;
     };
-    int ret = get_list_time(env, list, nullable, write_array, normalize_ex_value, ArrowArrayAppendInt);
+    int ret;
+    if (nanoarrow_type == NANOARROW_TYPE_TIME32) {
+        AdbcFixedWidthAppender<int32_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_time(env, list, nullable, appender, normalize_ex_value);
+    } else {
+        AdbcFixedWidthAppender<int64_t> appender;
+        NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+        ret = get_list_time(env, list, nullable, appender, normalize_ex_value);
+    }
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -686,80 +716,23 @@ int do_get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType
     return ret;
 }
 
-int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, uint64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+template <typename Normalize>
+int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<int64_t> &appender, const Normalize &normalize_ex_value) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int64_t val;
         if (erlang::nif::get(env, head, &val)) {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            appender.append(val);
         } else if (enif_is_map(env, head)) {
-            ERL_NIF_TERM struct_name_term, calendar_term, year_term, month_term, day_term, hour_term, minute_term, second_term, microsecond_term;
-            if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(struct_name_term, kAtomNaiveDateTimeModule)) {
-                return kErrorBufferWrongStruct;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                return kErrorExpectedCalendarISO;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomYearKey, &year_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMonthKey, &month_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomDayKey, &day_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomHourKey, &hour_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMinuteKey, &minute_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomSecondKey, &second_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMicrosecondKey, &microsecond_term)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            tm time{};
-            if (!erlang::nif::get(env, year_term, &time.tm_year) ||
-                !erlang::nif::get(env, month_term, &time.tm_mon) ||
-                !erlang::nif::get(env, day_term, &time.tm_mday) ||
-                !erlang::nif::get(env, hour_term, &time.tm_hour) ||
-                !erlang::nif::get(env, minute_term, &time.tm_min) ||
-                !erlang::nif::get(env, second_term, &time.tm_sec)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            const ERL_NIF_TERM *us_tuple = nullptr;
-            int us_arity;
-            uint64_t us;
-            int us_precision;
-            if (!enif_get_tuple(env, microsecond_term, &us_arity, &us_tuple) || us_arity != 2) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!erlang::nif::get(env, us_tuple[0], &us) || !erlang::nif::get(env, us_tuple[1], &us_precision)) {
-                return kErrorBufferGetMapValue;
+            int64_t us;
+            int ret = adbc_calendar_get_naive_datetime(env, head, val, us);
+            if (ret != 0) {
+                return ret;
             }
-
-            time.tm_year -= 1900;
-            time.tm_mon -= 1;
-            // mktime always gives local time
-            // so we need to adjust it to UTC
-            val = mktime(&time) + get_utc_offset() * 3600;
-            NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val, us)));
+            appender.append(normalize_ex_value(val, us));
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -767,21 +740,23 @@ int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct
     return 0;
 }
 
-int do_get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, uint64_t unit, const char * timezone, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, uint64_t unit, const char * timezone, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, nanoarrow_type, time_unit, timezone));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    auto normalize_ex_value = [=](int64_t val, uint64_t us) -> int64_t {
+    auto normalize_ex_value = [=](int64_t val, int64_t us) -> int64_t {
         if (time_unit == NANOARROW_TIME_UNIT_SECOND) {
             return val;
         }
         val = (val * 1000000 + us) * 1000 / unit;
         return val;
     };
-    int ret = get_list_timestamp(env, list, nullable, write_array, normalize_ex_value, ArrowArrayAppendInt);
+    AdbcFixedWidthAppender<int64_t> appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+    int ret = get_list_timestamp(env, list, nullable, appender, normalize_ex_value);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -789,15 +764,15 @@ int do_get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, Arro
     return ret;
 }
 
-int get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+int get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedWidthAppender<int64_t> &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int64_t val;
         if (erlang::nif::get(env, head, &val)) {
-            NANOARROW_RETURN_NOT_OK(callback(write_array, val));
+            appender.append(val);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -805,14 +780,16 @@ int get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct A
     return 0;
 }
 
-int do_get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, enum ArrowTimeUnit time_unit, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, nanoarrow_type, time_unit, NULL));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int ret = get_list_duration(env, list, nullable, write_array, ArrowArrayAppendInt);
+    AdbcFixedWidthAppender<int64_t> appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, n_items));
+    int ret = get_list_duration(env, list, nullable, appender);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -820,18 +797,17 @@ int do_get_list_duration(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, Arrow
     return ret;
 }
 
-int get_list_interval_month(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, struct ArrowInterval * val)> &callback) {
+// the intervals are appended as their packed little-endian layout,
+// see https://arrow.apache.org/docs/format/Columnar.html#interval
+int get_list_interval_month(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedSizeBinaryAppender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
-    struct ArrowInterval val{};
-    val.type = NANOARROW_TYPE_INTERVAL_MONTHS;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int32_t months;
         if (erlang::nif::get(env, head, &months)) {
-            val.months = months;
-            NANOARROW_RETURN_NOT_OK(callback(write_array, &val));
+            appender.append(&months);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -839,11 +815,9 @@ int get_list_interval_month(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, st
     return 0;
 }
 
-int get_list_interval_day_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, struct ArrowInterval * val)> &callback) {
+int get_list_interval_day_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedSizeBinaryAppender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
-    struct ArrowInterval val{};
-    val.type = NANOARROW_TYPE_INTERVAL_DAY_TIME;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int32_t days, milliseconds;
         const ERL_NIF_TERM *tuple = nullptr;
@@ -852,11 +826,12 @@ int get_list_interval_day_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable,
             if (!erlang::nif::get(env, tuple[0], &days) || !erlang::nif::get(env, tuple[1], &milliseconds)) {
                 return 1;
             }
-            val.days = days;
-            val.ms = milliseconds;
-            NANOARROW_RETURN_NOT_OK(callback(write_array, &val));
+            uint8_t val[8];
+            memcpy(val, &days, sizeof(int32_t));
+            memcpy(val + 4, &milliseconds, sizeof(int32_t));
+            appender.append(val);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -864,11 +839,9 @@ int get_list_interval_day_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable,
     return 0;
 }
 
-int get_list_duration_month_day_nano(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int(struct ArrowArray*, struct ArrowInterval * val)> &callback) {
+int get_list_duration_month_day_nano(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, AdbcFixedSizeBinaryAppender &appender) {
     ERL_NIF_TERM head, tail;
     tail = list;
-    struct ArrowInterval val{};
-    val.type = NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
         int32_t months, days;
         int64_t nanoseconds;
@@ -880,12 +853,13 @@ int get_list_duration_month_day_nano(ErlNifEnv *env, ERL_NIF_TERM list, bool nul
                 !erlang::nif::get(env, tuple[2], &nanoseconds)) {
                 return 1;
             }
-            val.months = months;
-            val.days = days;
-            val.ns = nanoseconds;
-            NANOARROW_RETURN_NOT_OK(callback(write_array, &val));
+            uint8_t val[16];
+            memcpy(val, &months, sizeof(int32_t));
+            memcpy(val + 4, &days, sizeof(int32_t));
+            memcpy(val + 8, &nanoseconds, sizeof(int64_t));
+            appender.append(val);
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
-            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
+            NANOARROW_RETURN_NOT_OK(appender.append_null());
         } else {
             return 1;
         }
@@ -893,26 +867,32 @@ int get_list_duration_month_day_nano(ErlNifEnv *env, ERL_NIF_TERM list, bool nul
     return 0;
 }
 
-int do_get_list_interval(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+int do_get_list_interval(ErlNifEnv *env, ERL_NIF_TERM list, unsigned n_items, bool nullable, ArrowType nanoarrow_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, nanoarrow_type));
 
     nanoarrow::UniqueArray tmp;
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    int(*get_list_interval)(ErlNifEnv *, ERL_NIF_TERM, bool, struct ArrowArray*, const std::function<int(struct ArrowArray*, struct ArrowInterval *)> &) = nullptr;
+    int(*get_list_interval)(ErlNifEnv *, ERL_NIF_TERM, bool, AdbcFixedSizeBinaryAppender &) = nullptr;
+    int64_t width;
 
     if (nanoarrow_type == NANOARROW_TYPE_INTERVAL_MONTHS) {
         get_list_interval = get_list_interval_month;
+        width = 4;
     } else if (nanoarrow_type == NANOARROW_TYPE_INTERVAL_DAY_TIME) {
         get_list_interval = get_list_interval_day_time;
+        width = 8;
     } else if (nanoarrow_type == NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO) {
         get_list_interval = get_list_duration_month_day_nano;
+        width = 16;
     } else {
         return 1;
     }
 
-    int ret = get_list_interval(env, list, nullable, write_array, ArrowArrayAppendInterval);
+    AdbcFixedSizeBinaryAppender appender;
+    NANOARROW_RETURN_NOT_OK(appender.reserve(write_array, width, n_items));
+    int ret = get_list_interval(env, list, nullable, appender);
     if (ret == 0) {
         NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
         ArrowArrayMove(tmp.get(), array_out);
@@ -920,6 +900,89 @@ int do_get_list_interval(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, Arrow
     return ret;
 }
 
+/// Returns true if `data` holds packed values, as given by `Adbc.Column.packed/3`
+/// or returned by materializing with `packed: true`: a map with a `values`
+/// binary and a `validity` bitmap binary or nil
+static bool adbc_column_data_is_packed(ErlNifEnv *env, ERL_NIF_TERM data, ERL_NIF_TERM *values, ERL_NIF_TERM *validity) {
+    return enif_is_map(env, data) &&
+        enif_get_map_value(env, data, kAtomValues, values) &&
+        enif_is_binary(env, *values) &&
+        enif_get_map_value(env, data, kAtomValidity, validity);
+}
+
+/// Wraps the packed values of a fixed-width column as the Arrow buffers of
+/// the array, without parsing nor (when they are aligned) copying them
+int do_get_packed(ErlNifEnv *env, ERL_NIF_TERM data, unsigned n_items, bool nullable, struct AdbcColumnType * column_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+    ERL_NIF_TERM values_term, validity_term;
+    if (!adbc_column_data_is_packed(env, data, &values_term, &validity_term)) {
+        return kErrorBufferDataIsNotAList;
+    }
+
+    switch (column_type->arrow_type) {
+    case NANOARROW_TYPE_TIME32:
+    case NANOARROW_TYPE_TIME64:
+    case NANOARROW_TYPE_DURATION:
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, column_type->arrow_type, column_type->time_unit, NULL));
+        break;
+    case NANOARROW_TYPE_TIMESTAMP:
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, column_type->arrow_type, column_type->time_unit, column_type->timezone.c_str()));
+        break;
+    default:
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, column_type->arrow_type));
+        break;
+    }
+
+    size_t element_size = arrow_packed_element_size(schema_out->format);
+    if (element_size == 0) {
+        enif_snprintf(error_out->message, sizeof(error_out->message), "packed values are not supported for columns of format `%s`", schema_out->format);
+        return kErrorInternalError;
+    }
+
+    ErlNifBinary values, validity;
+    enif_inspect_binary(env, values_term, &values);
+    bool has_validity = !enif_is_identical(validity_term, kAtomNil);
+    if (has_validity && !enif_inspect_binary(env, validity_term, &validity)) {
+        enif_snprintf(error_out->message, sizeof(error_out->message), "expected the validity of packed values to be a binary or nil");
+        return kErrorInternalError;
+    }
+    if (values.size < (size_t)n_items * element_size || (has_validity && validity.size < ((size_t)n_items + 7) / 8)) {
+        enif_snprintf(error_out->message, sizeof(error_out->message), "packed values are too short for a column of length %u", n_items);
+        return kErrorInternalError;
+    }
+
+    int64_t null_count = 0;
+    if (has_validity) {
+        null_count = (int64_t)n_items - adbc_bitmap_count_set(validity.data, 0, n_items);
+        if (null_count > 0 && !nullable) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "packed values of a non-nullable column have nulls");
+            return kErrorInternalError;
+        }
+    }
+
+    nanoarrow::UniqueArray tmp;
+    struct ArrowArray* write_array = tmp.get();
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
+
+    // buffers that can't be wrapped, because they are unaligned, are copied instead
+    struct ArrowBuffer * data_buffer = ArrowArrayBuffer(write_array, 1);
+    if (n_items > 0 && adbc_buffer_wrap_binary(env, values_term, element_size, data_buffer) != 0) {
+        NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(data_buffer, values.data, (int64_t)n_items * element_size));
+    }
+    if (null_count > 0) {
+        struct ArrowBitmap * bitmap = ArrowArrayValidityBitmap(write_array);
+        if (adbc_buffer_wrap_binary(env, validity_term, 1, &bitmap->buffer) != 0) {
+            NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(&bitmap->buffer, validity.data, ((int64_t)n_items + 7) / 8));
+        }
+        bitmap->size_bits = n_items;
+    }
+    write_array->length = n_items;
+    write_array->null_count = null_count;
+
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(write_array, error_out));
+    ArrowArrayMove(write_array, array_out);
+    return 0;
+}
+
 int do_get_list(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct AdbcColumnType * column_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
     if (column_type == nullptr) {
         enif_snprintf(error_out->message, sizeof(error_out->message), "internal error: column_type is null in do_get_list:%d", __LINE__);
@@ -994,6 +1057,8 @@ int do_get_list(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct AdbcCol
     case NANOARROW_TYPE_LARGE_BINARY:
     case NANOARROW_TYPE_STRING:
     case NANOARROW_TYPE_LARGE_STRING:
+    case NANOARROW_TYPE_BINARY_VIEW:
+    case NANOARROW_TYPE_STRING_VIEW:
     case NANOARROW_TYPE_DATE32:
     case NANOARROW_TYPE_DATE64:
     case NANOARROW_TYPE_LIST:
@@ -1133,6 +1198,17 @@ int must_be_adbc_column(ErlNifEnv *env,
         if (!enif_is_map(env, data_term)) {
             return kErrorBufferDataIsNotAMap;
         }
+    } else if (enif_is_map(env, data_term)) {
+        // packed values, their length can't be told without the type
+        ERL_NIF_TERM values_term, validity_term, length_term;
+        if (!adbc_column_data_is_packed(env, data_term, &values_term, &validity_term)) {
+            return kErrorBufferDataIsNotAList;
+        }
+        if (n_items) {
+            if (!enif_get_map_value(env, adbc_column, kAtomLengthKey, &length_term) || !erlang::nif::get(env, length_term, n_items)) {
+                return kErrorBufferGetDataListLength;
+            }
+        }
     } else {
         if (!enif_is_list(env, data_term)) {
             return kErrorBufferDataIsNotAList;
@@ -1183,6 +1259,10 @@ struct AdbcColumnType adbc_column_type_to_nanoarrow_type(ErlNifEnv *env, ERL_NIF
         ret.arrow_type = NANOARROW_TYPE_STRING;
     } else if (enif_is_identical(type_term, kAdbcColumnTypeLargeString)) {
         ret.arrow_type = NANOARROW_TYPE_LARGE_STRING;
+    } else if (enif_is_identical(type_term, kAdbcColumnTypeBinaryView)) {
+        ret.arrow_type = NANOARROW_TYPE_BINARY_VIEW;
+    } else if (enif_is_identical(type_term, kAdbcColumnTypeStringView)) {
+        ret.arrow_type = NANOARROW_TYPE_STRING_VIEW;
     } else if (enif_is_identical(type_term, kAdbcColumnTypeDate32)) {
         ret.arrow_type = NANOARROW_TYPE_DATE32;
     } else if (enif_is_identical(type_term, kAdbcColumnTypeDate64)) {
@@ -1357,42 +1437,48 @@ int adbc_column_to_adbc_field(ErlNifEnv *env, struct AdbcColumnNifTerm * column,
 
     int ret = kErrorBufferUnknownType;
     ERL_NIF_TERM data_term = column->data_term;
-    if (column_type.arrow_type == NANOARROW_TYPE_BOOL) {
-        ret = do_get_list_boolean(env, data_term, nullable, column_type.arrow_type, array_out, schema_out, error_out);
+    if (column_type.arrow_type != NANOARROW_TYPE_DICTIONARY && enif_is_map(env, data_term)) {
+        ret = do_get_packed(env, data_term, column->n_items, nullable, &column_type, array_out, schema_out, error_out);
+    } else if (column_type.arrow_type == NANOARROW_TYPE_BOOL) {
+        ret = do_get_list_boolean(env, data_term, column->n_items, nullable, column_type.arrow_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INT8) {
-        ret = do_get_list_integer<int8_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_INT8, array_out, schema_out, error_out);
+        ret = do_get_list_integer<int8_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_INT8, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_UINT8) {
-        ret = do_get_list_integer<uint8_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_UINT8, array_out, schema_out, error_out);
+        ret = do_get_list_integer<uint8_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_UINT8, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INT16) {
-        ret = do_get_list_integer<int16_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_INT16, array_out, schema_out, error_out);
+        ret = do_get_list_integer<int16_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_INT16, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_UINT16) {
-        ret = do_get_list_integer<uint16_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_UINT16, array_out, schema_out, error_out);
+        ret = do_get_list_integer<uint16_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_UINT16, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INT32) {
-        ret = do_get_list_integer<int32_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_INT32, array_out, schema_out, error_out);
+        ret = do_get_list_integer<int32_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_INT32, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_UINT32) {
-        ret = do_get_list_integer<uint32_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_UINT32, array_out, schema_out, error_out);
+        ret = do_get_list_integer<uint32_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_UINT32, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INT64) {
-        ret = do_get_list_integer<int64_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_INT64, array_out, schema_out, error_out);
+        ret = do_get_list_integer<int64_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_INT64, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_UINT64) {
-        ret = do_get_list_integer<uint64_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_UINT64, array_out, schema_out, error_out);
+        ret = do_get_list_integer<uint64_t>(env, data_term, column->n_items, nullable, skip_init, NANOARROW_TYPE_UINT64, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_HALF_FLOAT) {
-        ret = do_get_list_half_float(env, data_term, nullable, NANOARROW_TYPE_HALF_FLOAT, array_out, schema_out, error_out);
+        ret = do_get_list_half_float(env, data_term, column->n_items, nullable, NANOARROW_TYPE_HALF_FLOAT, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_FLOAT) {
-        ret = do_get_list_float(env, data_term, nullable, NANOARROW_TYPE_FLOAT, array_out, schema_out, error_out);
+        ret = do_get_list_float(env, data_term, column->n_items, nullable, NANOARROW_TYPE_FLOAT, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DOUBLE) {
-        ret = do_get_list_float(env, data_term, nullable, NANOARROW_TYPE_DOUBLE, array_out, schema_out, error_out);
+        ret = do_get_list_float(env, data_term, column->n_items, nullable, NANOARROW_TYPE_DOUBLE, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_BINARY) {
-        ret = do_get_list_string(env, data_term, nullable, NANOARROW_TYPE_BINARY, array_out, schema_out, error_out);
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_BINARY, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_LARGE_BINARY) {
-        ret = do_get_list_string(env, data_term, nullable, NANOARROW_TYPE_LARGE_BINARY, array_out, schema_out, error_out);
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_LARGE_BINARY, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_STRING) {
-        ret = do_get_list_string(env, data_term, nullable, NANOARROW_TYPE_STRING, array_out, schema_out, error_out);
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_STRING, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_LARGE_STRING) {
-        ret = do_get_list_string(env, data_term, nullable, NANOARROW_TYPE_LARGE_STRING, array_out, schema_out, error_out);
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_LARGE_STRING, array_out, schema_out, error_out);
+    } else if (column_type.arrow_type == NANOARROW_TYPE_BINARY_VIEW) {
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_BINARY_VIEW, array_out, schema_out, error_out);
+    } else if (column_type.arrow_type == NANOARROW_TYPE_STRING_VIEW) {
+        ret = do_get_list_string(env, data_term, column->n_items, nullable, NANOARROW_TYPE_STRING_VIEW, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DATE32) {
-        ret = do_get_list_date(env, data_term, nullable, NANOARROW_TYPE_DATE32, array_out, schema_out, error_out);
+        ret = do_get_list_date(env, data_term, column->n_items, nullable, NANOARROW_TYPE_DATE32, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DATE64) {
-        ret = do_get_list_date(env, data_term, nullable, NANOARROW_TYPE_DATE64, array_out, schema_out, error_out);
+        ret = do_get_list_date(env, data_term, column->n_items, nullable, NANOARROW_TYPE_DATE64, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_LIST) {
         ret = do_get_list(env, data_term, nullable, &column_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_LARGE_LIST) {
@@ -1400,21 +1486,21 @@ int adbc_column_to_adbc_field(ErlNifEnv *env, struct AdbcColumnNifTerm * column,
     } else if (column_type.arrow_type == NANOARROW_TYPE_FIXED_SIZE_LIST) {
         ret = do_get_list(env, data_term, nullable, &column_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_TIME32 || column_type.arrow_type == NANOARROW_TYPE_TIME64) {
-        ret = do_get_list_time(env, data_term, nullable, column_type.arrow_type, column_type.time_unit, column_type.unit, array_out, schema_out, error_out);
+        ret = do_get_list_time(env, data_term, column->n_items, nullable, column_type.arrow_type, column_type.time_unit, column_type.unit, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DURATION) {
-        ret = do_get_list_duration(env, data_term, nullable, column_type.arrow_type, column_type.time_unit, array_out, schema_out, error_out);
+        ret = do_get_list_duration(env, data_term, column->n_items, nullable, column_type.arrow_type, column_type.time_unit, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_TIMESTAMP) {
-        ret = do_get_list_timestamp(env, data_term, nullable, column_type.arrow_type, column_type.time_unit, column_type.unit, column_type.timezone.c_str(), array_out, schema_out, error_out);
+        ret = do_get_list_timestamp(env, data_term, column->n_items, nullable, column_type.arrow_type, column_type.time_unit, column_type.unit, column_type.timezone.c_str(), array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INTERVAL_MONTHS) {
-        ret = do_get_list_interval(env, data_term, nullable, column_type.arrow_type, array_out, schema_out, error_out);
+        ret = do_get_list_interval(env, data_term, column->n_items, nullable, column_type.arrow_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INTERVAL_DAY_TIME) {
-        ret = do_get_list_interval(env, data_term, nullable, column_type.arrow_type, array_out, schema_out, error_out);
+        ret = do_get_list_interval(env, data_term, column->n_items, nullable, column_type.arrow_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO) {
-        ret = do_get_list_interval(env, data_term, nullable, column_type.arrow_type, array_out, schema_out, error_out);
+        ret = do_get_list_interval(env, data_term, column->n_items, nullable, column_type.arrow_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_FIXED_SIZE_BINARY) {
-        ret = do_get_list_fixed_size_binary(env, data_term, nullable, column_type.arrow_type, column_type.fixed_size, array_out, schema_out, error_out);
+        ret = do_get_list_fixed_size_binary(env, data_term, column->n_items, nullable, column_type.arrow_type, column_type.fixed_size, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DECIMAL128 || column_type.arrow_type == NANOARROW_TYPE_DECIMAL256) {
-        ret = do_get_list_decimal(env, data_term, nullable, column_type.arrow_type, column_type.bits, column_type.precision, column_type.scale, array_out, schema_out, error_out);
+        ret = do_get_list_decimal(env, data_term, column->n_items, nullable, column_type.arrow_type, column_type.bits, column_type.precision, column_type.scale, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DICTIONARY) {
         ret = do_get_dictionary(env, data_term, nullable, array_out, schema_out, error_out);
     }
@@ -1513,7 +1599,7 @@ int adbc_column_to_arrow_type_struct(ErlNifEnv *env, ERL_NIF_TERM values, struct
                 return 1;
             case kErrorBufferGetDataListLength:
             case kErrorBufferDataIsNotAList:
-                snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of `Adbc.Column` to be a list of values.");
+                snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of `Adbc.Column` to be a list of values or packed values.");
                 return 1;
             case kErrorBufferDataIsNotAMap:
                 snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of dictionary `Adbc.Column` to be a map.");
@@ -1602,4 +1688,396 @@ int adbc_column_to_arrow_type_struct(ErlNifEnv *env, ERL_NIF_TERM values, struct
     return !(processed == n_items);
 }
 
+// precision of the decimals inferred from `%Decimal{}` parameters
+constexpr int kAdbcRowDecimalPrecision = 38;
+
+/// The parameters at one position of the rows given to `adbc_rows_to_arrow_type_struct`
+struct AdbcRowParameter {
+    // NANOARROW_TYPE_NA until the first value that is not nil
+    ArrowType type = NANOARROW_TYPE_NA;
+    // total size of the binary values, to reserve the data buffer of strings
+    int64_t binary_size = 0;
+    // largest number of digits after the point of the decimals
+    int scale = 0;
+    // integers, and microseconds for times and timestamps
+    AdbcFixedWidthAppender<int64_t> integers;
+    AdbcFixedWidthAppender<int32_t> dates;
+    AdbcFixedWidthAppender<double> floats;
+    AdbcFixedWidthAppender<bool> booleans;
+    AdbcVarBinaryAppender<int32_t> strings;
+    AdbcFixedSizeBinaryAppender decimals;
+
+    // set if the first parameter that is not nil is an `%Adbc.Column{}`,
+    // the values of all of them are then concatenated into `column_values`
+    ERL_NIF_TERM column = 0;
+    ERL_NIF_TERM column_type = 0;
+    std::vector<ERL_NIF_TERM> column_values;
+};
+
+/// Infers the type of the child of `column` from `param`, its first
+/// parameter that is not nil
+///
+/// @return 0 on success, 1 if `param` cannot be bound
+static int adbc_row_parameter_infer(ErlNifEnv *env, ERL_NIF_TERM param, AdbcRowParameter &column) {
+    double f64;
+    ERL_NIF_TERM struct_name;
+    if (enif_is_number(env, param)) {
+        column.type = enif_get_double(env, param, &f64) ? NANOARROW_TYPE_DOUBLE : NANOARROW_TYPE_INT64;
+    } else if (enif_is_binary(env, param) || enif_is_list(env, param)) {
+        column.type = NANOARROW_TYPE_STRING;
+    } else if (enif_is_identical(param, kAtomTrue) || enif_is_identical(param, kAtomFalse)) {
+        column.type = NANOARROW_TYPE_BOOL;
+    } else if (!enif_is_map(env, param) || !enif_get_map_value(env, param, kAtomStructKey, &struct_name)) {
+        return 1;
+    } else if (enif_is_identical(struct_name, kAtomDateModule)) {
+        column.type = NANOARROW_TYPE_DATE32;
+    } else if (enif_is_identical(struct_name, kAtomTimeModule)) {
+        column.type = NANOARROW_TYPE_TIME64;
+    } else if (enif_is_identical(struct_name, kAtomNaiveDateTimeModule)) {
+        column.type = NANOARROW_TYPE_TIMESTAMP;
+    } else if (enif_is_identical(struct_name, kAtomDecimalModule)) {
+        column.type = NANOARROW_TYPE_DECIMAL128;
+    } else if (enif_is_identical(struct_name, kAtomAdbcColumnModule) && enif_get_map_value(env, param, kAtomTypeKey, &column.column_type)) {
+        column.column = param;
+    } else {
+        return 1;
+    }
+    return 0;
+}
+
+/// Appends `param` to the child of `column`
+///
+/// @return 0 on success, 1 if `param` does not have the type of the child,
+/// `kErrorExpectedCalendarISO` for a calendar struct in another calendar,
+/// otherwise the error of the appender
+static int adbc_row_parameter_append(ErlNifEnv *env, ERL_NIF_TERM param, AdbcRowParameter &column) {
+    bool is_nil = enif_is_identical(param, kAtomNil);
+    ErlNifSInt64 i64;
+    double f64;
+    ErlNifBinary bytes;
+    int64_t days, seconds, us;
+    int ret = 1;
+    switch (column.type) {
+    case NANOARROW_TYPE_INT64:
+        if (is_nil) {
+            return column.integers.append_null();
+        } else if (!enif_get_int64(env, param, &i64)) {
+            return 1;
+        }
+        column.integers.append(i64);
+        return 0;
+    case NANOARROW_TYPE_DOUBLE:
+        if (is_nil) {
+            return column.floats.append_null();
+        } else if (enif_get_double(env, param, &f64)) {
+            column.floats.append(f64);
+        } else if (enif_get_int64(env, param, &i64)) {
+            column.floats.append((double)i64);
+        } else {
+            return 1;
+        }
+        return 0;
+    case NANOARROW_TYPE_BOOL:
+        if (is_nil) {
+            return column.booleans.append_null();
+        } else if (!enif_is_identical(param, kAtomTrue) && !enif_is_identical(param, kAtomFalse)) {
+            return 1;
+        }
+        column.booleans.append(enif_is_identical(param, kAtomTrue));
+        return 0;
+    case NANOARROW_TYPE_STRING:
+        if (is_nil) {
+            return column.strings.append_null();
+        } else if (!enif_inspect_iolist_as_binary(env, param, &bytes)) {
+            return 1;
+        }
+        return column.strings.append(bytes.data, (int64_t)bytes.size);
+    case NANOARROW_TYPE_DATE32:
+        if (is_nil) {
+            return column.dates.append_null();
+        } else if (enif_is_map(env, param)) {
+            ret = adbc_calendar_get_date(env, param, days);
+        }
+        if (ret != 0) {
+            return ret == kErrorExpectedCalendarISO ? ret : 1;
+        } else if (days < INT32_MIN || days > INT32_MAX) {
+            return 1;
+        }
+        column.dates.append((int32_t)days);
+        return 0;
+    case NANOARROW_TYPE_TIME64:
+    case NANOARROW_TYPE_TIMESTAMP:
+        if (is_nil) {
+            return column.integers.append_null();
+        } else if (enif_is_map(env, param) && column.type == NANOARROW_TYPE_TIME64) {
+            ret = adbc_calendar_get_time(env, param, seconds, us);
+        } else if (enif_is_map(env, param)) {
+            ret = adbc_calendar_get_naive_datetime(env, param, seconds, us);
+        }
+        if (ret != 0) {
+            return ret == kErrorExpectedCalendarISO ? ret : 1;
+        }
+        column.integers.append(seconds * 1000000 + us);
+        return 0;
+    case NANOARROW_TYPE_DECIMAL128: {
+        uint64_t words[2];
+        if (is_nil) {
+            return column.decimals.append_null();
+        } else if (!enif_is_map(env, param) || !adbc_decimal_from_nif(env, param, kAdbcRowDecimalPrecision, column.scale, words, 2)) {
+            return 1;
+        }
+        column.decimals.append(words);
+        return 0;
+    }
+    default:
+        return 1;
+    }
+}
+
+/// Appends `param` to the values of the `%Adbc.Column{}` parameters of `column`
+/// @return 0 on success, 1 if `param` is not a column of their type with one value
+static int adbc_row_parameter_append_column(ErlNifEnv *env, ERL_NIF_TERM param, AdbcRowParameter &column) {
+    if (enif_is_identical(param, kAtomNil)) {
+        column.column_values.push_back(kAtomNil);
+        return 0;
+    }
+
+    ERL_NIF_TERM struct_name, type, data, value, rest;
+    unsigned length = 0;
+    if (!enif_is_map(env, param)
+        || !enif_get_map_value(env, param, kAtomStructKey, &struct_name) || !enif_is_identical(struct_name, kAtomAdbcColumnModule)
+        || !enif_get_map_value(env, param, kAtomTypeKey, &type) || !enif_is_identical(type, column.column_type)
+        || !enif_get_map_value(env, param, kAtomDataKey, &data)
+        || !enif_get_list_length(env, data, &length) || length != 1
+        || !enif_get_list_cell(env, data, &value, &rest)) {
+        return 1;
+    }
+    column.column_values.push_back(value);
+    return 0;
+}
+
+/// Calls `fun(index, param)` for every parameter in `row`, a tuple or a list,
+/// and sets `n_params` to their number
+///
+/// @return 0 on success, -1 if `row` is neither a tuple nor a list,
+/// otherwise the first non-zero value returned by `fun`
+template <typename F>
+int adbc_row_for_each(ErlNifEnv *env, ERL_NIF_TERM row, int64_t * n_params, const F &fun) {
+    int arity = 0;
+    const ERL_NIF_TERM * params = nullptr;
+    if (enif_get_tuple(env, row, &arity, &params)) {
+        *n_params = arity;
+        for (int i = 0; i < arity; i++) {
+            NANOARROW_RETURN_NOT_OK(fun((int64_t)i, params[i]));
+        }
+        return 0;
+    }
+
+    if (!enif_is_list(env, row)) {
+        return -1;
+    }
+    *n_params = 0;
+    ERL_NIF_TERM head, tail;
+    tail = row;
+    while (enif_get_list_cell(env, tail, &head, &tail)) {
+        NANOARROW_RETURN_NOT_OK(fun(*n_params, head));
+        (*n_params)++;
+    }
+    return 0;
+}
+
+/// Converts `rows`, a list of parameter tuples (or lists), into a struct with
+/// one child per parameter and one row per tuple, so that a statement runs
+/// for all of them with a single bind.
+///
+/// The type of each child is inferred from the first of its parameters that
+/// is not nil: integers become int64, floats become double (integers are
+/// accepted after a float), binaries and iolists become strings, booleans
+/// become bool, `%Date{}` becomes date32, `%Time{}` and `%NaiveDateTime{}`
+/// become time64 and timestamp in microseconds, and `%Decimal{}` becomes
+/// decimal128 with the largest scale of the child. `%Adbc.Column{}`
+/// parameters of one value each are concatenated into a column of their
+/// type. Children where all parameters are nil have the null type.
+int adbc_rows_to_arrow_type_struct(ErlNifEnv *env, ERL_NIF_TERM rows, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+    unsigned n_rows = 0;
+    ERL_NIF_TERM row, tail;
+    if (!enif_get_list_length(env, rows, &n_rows) || !enif_get_list_cell(env, rows, &row, &tail)) {
+        enif_snprintf(error_out->message, sizeof(error_out->message), "expected a non-empty list of parameter rows");
+        return 1;
+    }
+
+    int64_t n_params = 0;
+    if (adbc_row_for_each(env, row, &n_params, [](int64_t, ERL_NIF_TERM) { return 0; }) != 0 || n_params == 0) {
+        enif_snprintf(error_out->message, sizeof(error_out->message), "expected each parameter row to be a non-empty tuple or list, got: `%T`", row);
+        return 1;
+    }
+    std::vector<AdbcRowParameter> columns((size_t)n_params);
+
+    // infers the types, checks that the rows have the same length and sums
+    // the sizes of the binaries
+    tail = rows;
+    unsigned row_index = 0;
+    while (enif_get_list_cell(env, tail, &row, &tail)) {
+        int64_t length = 0;
+        int ret = adbc_row_for_each(env, row, &length, [&](int64_t i, ERL_NIF_TERM param) {
+            if (i >= n_params) {
+                return EINVAL;
+            }
+            AdbcRowParameter &column = columns[(size_t)i];
+            ErlNifBinary bytes;
+            if (enif_inspect_binary(env, param, &bytes)) {
+                column.binary_size += (int64_t)bytes.size;
+            }
+            if (enif_is_identical(param, kAtomNil)) {
+                return 0;
+            }
+            if (column.type == NANOARROW_TYPE_NA && column.column == 0 && adbc_row_parameter_infer(env, param, column) != 0) {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "unsupported parameter `%T` in row %u", param, row_index);
+                return 1;
+            }
+
+            // decimals are scaled to the largest scale of the child
+            int exp = 0;
+            if (column.type == NANOARROW_TYPE_DECIMAL128 && adbc_decimal_get_exp(env, param, exp) && -exp > column.scale) {
+                if (-exp > kAdbcRowDecimalPrecision) {
+                    enif_snprintf(error_out->message, sizeof(error_out->message), "parameter `%T` in row %u has more than %d digits after the point", param, row_index, kAdbcRowDecimalPrecision);
+                    return 1;
+                }
+                column.scale = -exp;
+            }
+            return 0;
+        });
+        if (ret == -1) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "expected each parameter row to be a tuple or list, got: `%T`", row);
+            return 1;
+        } else if (ret == EINVAL || (ret == 0 && length != n_params)) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "expected row %u to have %ld parameters, got: `%T`", row_index, (long)n_params, row);
+            return 1;
+        } else if (ret != 0) {
+            return ret;
+        }
+        row_index++;
+    }
+
+    ArrowSchemaInit(schema_out);
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema_out, n_params));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromType(array_out, NANOARROW_TYPE_STRUCT));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAllocateChildren(array_out, n_params));
+    for (int64_t i = 0; i < n_params; i++) {
+        AdbcRowParameter &column = columns[(size_t)i];
+        if (column.column != 0) {
+            // built once the values of all rows are known
+            column.column_values.reserve(n_rows);
+            continue;
+        }
+
+        auto schema_i = schema_out->children[i];
+        auto child_i = array_out->children[i];
+        switch (column.type) {
+        case NANOARROW_TYPE_TIME64:
+        case NANOARROW_TYPE_TIMESTAMP:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_i, column.type, NANOARROW_TIME_UNIT_MICRO, nullptr));
+            break;
+        case NANOARROW_TYPE_DECIMAL128:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDecimal(schema_i, column.type, kAdbcRowDecimalPrecision, column.scale));
+            break;
+        default:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_i, column.type));
+            break;
+        }
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema_i, ""));
+        NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(child_i, schema_i, error_out));
+        NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(child_i));
+        switch (column.type) {
+        case NANOARROW_TYPE_INT64:
+        case NANOARROW_TYPE_TIME64:
+        case NANOARROW_TYPE_TIMESTAMP:
+            NANOARROW_RETURN_NOT_OK(column.integers.reserve(child_i, n_rows));
+            break;
+        case NANOARROW_TYPE_DATE32:
+            NANOARROW_RETURN_NOT_OK(column.dates.reserve(child_i, n_rows));
+            break;
+        case NANOARROW_TYPE_DECIMAL128:
+            NANOARROW_RETURN_NOT_OK(column.decimals.reserve(child_i, 16, n_rows));
+            break;
+        case NANOARROW_TYPE_DOUBLE:
+            NANOARROW_RETURN_NOT_OK(column.floats.reserve(child_i, n_rows));
+            break;
+        case NANOARROW_TYPE_BOOL:
+            NANOARROW_RETURN_NOT_OK(column.booleans.reserve(child_i, n_rows));
+            break;
+        case NANOARROW_TYPE_STRING:
+            NANOARROW_RETURN_NOT_OK(column.strings.reserve(child_i, n_rows));
+            NANOARROW_RETURN_NOT_OK(column.strings.reserve_data(column.binary_size));
+            break;
+        default:
+            NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(child_i, n_rows));
+            break;
+        }
+    }
+
+    tail = rows;
+    row_index = 0;
+    while (enif_get_list_cell(env, tail, &row, &tail)) {
+        int64_t length = 0;
+        int status = adbc_row_for_each(env, row, &length, [&](int64_t i, ERL_NIF_TERM param) {
+            AdbcRowParameter &column = columns[(size_t)i];
+            if (column.column != 0) {
+                if (adbc_row_parameter_append_column(env, param, column) != 0) {
+                    enif_snprintf(error_out->message, sizeof(error_out->message), "parameter `%T` in row %u is not an `Adbc.Column` with one value of the type `%T` inferred for position %ld", param, row_index, column.column_type, (long)i);
+                    return 1;
+                }
+                return 0;
+            }
+            if (column.type == NANOARROW_TYPE_NA) {
+                return 0;
+            }
+
+            int ret = adbc_row_parameter_append(env, param, column);
+            if (ret == kErrorExpectedCalendarISO) {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "parameter `%T` in row %u is not in `Calendar.ISO`", param, row_index);
+                return 1;
+            } else if (ret == 1) {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "parameter `%T` in row %u does not have the type %s inferred for position %ld", param, row_index, ArrowTypeString(column.type), (long)i);
+            } else if (ret != 0) {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "cannot append parameter at position %ld in row %u: %s", (long)i, row_index, strerror(ret));
+            }
+            return ret;
+        });
+        if (status != 0) {
+            return status;
+        }
+        row_index++;
+    }
+
+    // the children of `%Adbc.Column{}` parameters go through the same path
+    // as the columns bound by `adbc_column_to_arrow_type_struct`
+    for (int64_t i = 0; i < n_params; i++) {
+        AdbcRowParameter &column = columns[(size_t)i];
+        if (column.column == 0) {
+            continue;
+        }
+
+        ERL_NIF_TERM data = enif_make_list_from_array(env, column.column_values.data(), (unsigned)column.column_values.size());
+        ERL_NIF_TERM adbc_column;
+        if (!enif_make_map_put(env, column.column, kAtomDataKey, data, &adbc_column) ||
+            !enif_make_map_put(env, adbc_column, kAtomNullableKey, kAtomTrue, &adbc_column)) {
+            return ENOMEM;
+        }
+        ArrowSchemaInit(schema_out->children[i]);
+        unsigned n_items = 0;
+        int ret = adbc_column_to_adbc_field(env, adbc_column, false, array_out->children[i], schema_out->children[i], error_out, &n_items);
+        if (ret != 0) {
+            if (error_out->message[0] == '\0') {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "cannot bind the `Adbc.Column` parameters at position %ld", (long)i);
+            }
+            return ret;
+        }
+    }
+
+    array_out->length = n_rows;
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(array_out, error_out));
+    return 0;
+}
+
 #endif  // ADBC_COLUMN_HPP
@@ -17,6 +17,7 @@ static ERL_NIF_TERM kAtomInfinity;
 static ERL_NIF_TERM kAtomNegInfinity;
 static ERL_NIF_TERM kAtomNaN;
 static ERL_NIF_TERM kAtomEndOfSeries;
+static ERL_NIF_TERM kAtomPending;
 static ERL_NIF_TERM kAtomStructKey;
 // for the data field in list views and large list views
 // %Adbc.Column{
@@ -43,6 +44,18 @@ static ERL_NIF_TERM kAtomSizes;
 static ERL_NIF_TERM kAtomValues;
 static ERL_NIF_TERM kAtomRunEnds;
 
+// materialize options
+static ERL_NIF_TERM kAtomZeroCopy;
+static ERL_NIF_TERM kAtomPacked;
+static ERL_NIF_TERM kAtomExpandDictionary;
+static ERL_NIF_TERM kAtomExpand;
+static ERL_NIF_TERM kAtomInternStrings;
+static ERL_NIF_TERM kAtomMaps;
+static ERL_NIF_TERM kAtomDuplicateKeys;
+static ERL_NIF_TERM kAtomFirst;
+static ERL_NIF_TERM kAtomLast;
+static ERL_NIF_TERM kAtomError;
+
 static ERL_NIF_TERM kAtomDecimal;
 static ERL_NIF_TERM kAtomFixedSizeBinary;
 static ERL_NIF_TERM kAtomFixedSizeList;
@@ -74,6 +87,11 @@ static ERL_NIF_TERM kAtomMinuteKey;
 static ERL_NIF_TERM kAtomSecondKey;
 static ERL_NIF_TERM kAtomMicrosecondKey;
 
+static ERL_NIF_TERM kAtomDecimalModule;
+static ERL_NIF_TERM kAtomSignKey;
+static ERL_NIF_TERM kAtomCoefKey;
+static ERL_NIF_TERM kAtomExpKey;
+
 static ERL_NIF_TERM kAtomAdbcColumnModule;
 static ERL_NIF_TERM kAtomNameKey;
 static ERL_NIF_TERM kAtomTypeKey;
@@ -100,6 +118,8 @@ static ERL_NIF_TERM kAdbcColumnTypeBinary;
 static ERL_NIF_TERM kAdbcColumnTypeLargeBinary;
 static ERL_NIF_TERM kAdbcColumnTypeString;
 static ERL_NIF_TERM kAdbcColumnTypeLargeString;
+static ERL_NIF_TERM kAdbcColumnTypeBinaryView;
+static ERL_NIF_TERM kAdbcColumnTypeStringView;
 #define kAdbcColumnTypeDecimal(bitwidth, precision, scale) enif_make_tuple4(env, kAtomDecimal, enif_make_int(env, bitwidth), enif_make_int(env, precision), enif_make_int(env, scale))
 #define kAdbcColumnTypeFixedSizeBinary(nbytes) enif_make_tuple2(env, kAtomFixedSizeBinary, enif_make_int64(env, nbytes))
 static ERL_NIF_TERM kAdbcColumnTypeDate32;
@@ -0,0 +1,201 @@
+#ifndef ADBC_DECIMAL_HPP
+#define ADBC_DECIMAL_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <erl_nif.h>
+#include "adbc_consts.h"
+
+/// Reads a little-endian two's complement integer of `bits` bits (32, 64,
+/// 128 or 256) into its sign and `(bits + 63) / 64` words of magnitude
+///
+/// @return true if the value is negative
+static inline bool adbc_decimal_magnitude(const uint8_t * bytes, int bits, uint64_t * magnitude) {
+    int nbytes = bits / 8;
+    int nwords = (nbytes + 7) / 8;
+    // Arrow buffers are in native byte order, and every target we build for is little-endian
+    bool negative = (bytes[nbytes - 1] & 0x80) != 0;
+    memset(magnitude, negative ? 0xFF : 0, (size_t)nwords * sizeof(uint64_t));
+    memcpy(magnitude, bytes, (size_t)nbytes);
+    if (negative) {
+        // two's complement, the magnitude of the smallest value still fits unsigned
+        uint64_t carry = 1;
+        for (int i = 0; i < nwords; i++) {
+            magnitude[i] = ~magnitude[i] + carry;
+            carry = (carry && magnitude[i] == 0) ? 1 : 0;
+        }
+    }
+    return negative;
+}
+
+/// Returns the non-negative integer `magnitude` (`nwords` little-endian words)
+///
+/// Values that fit into 64 bits are made directly, larger ones are
+/// decoded from a SMALL_BIG_EXT in the external term format, which has
+/// the same little-endian layout, instead of being built up with
+/// bignum arithmetic in Elixir.
+static ERL_NIF_TERM adbc_decimal_make_coef(ErlNifEnv *env, const uint64_t * magnitude, int nwords) {
+    int used = nwords;
+    while (used > 1 && magnitude[used - 1] == 0) {
+        used--;
+    }
+    if (used == 1) {
+        return enif_make_uint64(env, magnitude[0]);
+    }
+
+    // version, SMALL_BIG_EXT, number of bytes, sign, then the bytes
+    unsigned char ext[4 + 4 * sizeof(uint64_t)];
+    size_t nbytes = 0;
+    for (int i = 0; i < used; i++) {
+        for (int b = 0; b < 8; b++) {
+            ext[4 + nbytes++] = (unsigned char)(magnitude[i] >> (8 * b));
+        }
+    }
+    while (ext[4 + nbytes - 1] == 0) {
+        nbytes--;
+    }
+    ext[0] = 131;
+    ext[1] = 110;
+    ext[2] = (unsigned char)nbytes;
+    ext[3] = 0;
+
+    ERL_NIF_TERM coef;
+    if (enif_binary_to_term(env, ext, 4 + nbytes, &coef, (ErlNifBinaryToTerm)0) == 0) {
+        return kAtomNil;
+    }
+    return coef;
+}
+
+/// Returns a `%Decimal{}` for a decimal value of `bits` bits (at most 256) with `scale`
+static ERL_NIF_TERM adbc_decimal_to_nif(ErlNifEnv *env, const uint8_t * bytes, int bits, int scale) {
+    uint64_t magnitude[4];
+    int nwords = (bits / 8 + 7) / 8;
+    bool negative = adbc_decimal_magnitude(bytes, bits, magnitude);
+
+    ERL_NIF_TERM keys[] = {
+        kAtomStructKey,
+        kAtomCoefKey,
+        kAtomExpKey,
+        kAtomSignKey,
+    };
+    ERL_NIF_TERM values[] = {
+        kAtomDecimalModule,
+        adbc_decimal_make_coef(env, magnitude, nwords),
+        enif_make_int(env, -scale),
+        enif_make_int(env, negative ? -1 : 1),
+    };
+    ERL_NIF_TERM map;
+    enif_make_map_from_arrays(env, keys, values, 4, &map);
+    return map;
+}
+
+/// Multiplies the non-negative integer `magnitude` (`nwords` little-endian words) by 10
+/// @return false if the result does not fit into `nwords` words
+static inline bool adbc_decimal_mul10(uint64_t * magnitude, int nwords) {
+    uint64_t carry = 0;
+    for (int i = 0; i < nwords; i++) {
+        // in halves of 32 bits so that no product overflows
+        uint64_t lo = (magnitude[i] & 0xFFFFFFFF) * 10 + carry;
+        uint64_t hi = (magnitude[i] >> 32) * 10 + (lo >> 32);
+        magnitude[i] = (hi << 32) | (lo & 0xFFFFFFFF);
+        carry = hi >> 32;
+    }
+    return carry == 0;
+}
+
+/// Reads the non-negative integer `term` into `nwords` little-endian words,
+/// the inverse of adbc_decimal_make_coef
+///
+/// @return false if `term` is not a non-negative integer that fits
+static bool adbc_decimal_get_coef(ErlNifEnv *env, ERL_NIF_TERM term, uint64_t * magnitude, int nwords) {
+    memset(magnitude, 0, (size_t)nwords * sizeof(uint64_t));
+    ErlNifUInt64 u64;
+    if (enif_get_uint64(env, term, &u64)) {
+        magnitude[0] = u64;
+        return true;
+    }
+    if (!enif_is_number(env, term)) {
+        return false;
+    }
+
+    // larger integers are read from their SMALL_BIG_EXT
+    ErlNifBinary ext;
+    if (!enif_term_to_binary(env, term, &ext)) {
+        return false;
+    }
+    bool ok = ext.size >= 4 && ext.data[0] == 131 && ext.data[1] == 110 && ext.data[3] == 0
+        && ext.data[2] <= nwords * sizeof(uint64_t) && ext.size == 4 + (size_t)ext.data[2];
+    if (ok) {
+        for (size_t b = 0; b < ext.data[2]; b++) {
+            magnitude[b / 8] |= (uint64_t)ext.data[4 + b] << (8 * (b % 8));
+        }
+    }
+    enif_release_binary(&ext);
+    return ok;
+}
+
+/// Gets the exponent of the `%Decimal{}` `map`
+/// @return false if `map` is not a `%Decimal{}`
+static bool adbc_decimal_get_exp(ErlNifEnv *env, ERL_NIF_TERM map, int &exp) {
+    ERL_NIF_TERM struct_name, exp_term;
+    return enif_get_map_value(env, map, kAtomStructKey, &struct_name)
+        && enif_is_identical(struct_name, kAtomDecimalModule)
+        && enif_get_map_value(env, map, kAtomExpKey, &exp_term)
+        && enif_get_int(env, exp_term, &exp);
+}
+
+/// Encodes the `%Decimal{}` `map` as a little-endian two's complement integer
+/// of `nwords` words, the inverse of adbc_decimal_to_nif
+///
+/// @return false if `map` is not a finite decimal with at most `scale`
+/// digits after the point and `precision` digits in total
+static bool adbc_decimal_from_nif(ErlNifEnv *env, ERL_NIF_TERM map, int precision, int scale, uint64_t * words, int nwords) {
+    int exp;
+    ERL_NIF_TERM coef_term, sign_term;
+    int sign;
+    if (!adbc_decimal_get_exp(env, map, exp) || scale + exp < 0
+        || !enif_get_map_value(env, map, kAtomCoefKey, &coef_term)
+        || !enif_get_map_value(env, map, kAtomSignKey, &sign_term)
+        || !enif_get_int(env, sign_term, &sign)) {
+        return false;
+    }
+    if (!adbc_decimal_get_coef(env, coef_term, words, nwords)) {
+        return false;
+    }
+    for (int i = 0; i < scale + exp; i++) {
+        if (!adbc_decimal_mul10(words, nwords)) {
+            return false;
+        }
+    }
+
+    // the value must be below 10^precision
+    uint64_t limit[4] = {1, 0, 0, 0};
+    for (int i = 0; i < precision; i++) {
+        if (!adbc_decimal_mul10(limit, nwords)) {
+            break;
+        }
+    }
+    for (int i = nwords - 1; i >= 0; i--) {
+        if (words[i] != limit[i]) {
+            if (words[i] > limit[i]) {
+                return false;
+            }
+            break;
+        }
+        if (i == 0) {
+            return false;
+        }
+    }
+
+    if (sign < 0) {
+        uint64_t carry = 1;
+        for (int i = 0; i < nwords; i++) {
+            words[i] = ~words[i] + carry;
+            carry = (carry && words[i] == 0) ? 1 : 0;
+        }
+    }
+    return true;
+}
+
+#endif  // ADBC_DECIMAL_HPP
@@ -0,0 +1,101 @@
+#ifndef ADBC_DECODER_PLAN_HPP
+#define ADBC_DECODER_PLAN_HPP
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+
+struct AdbcMaterializeOptions;
+struct AdbcDecoderPlanNode;
+
+/// Decodes `count` values of a leaf array, starting at `offset`, into a list
+/// followed by the elements of the list `tail`, or by none if `tail` is 0
+/// @return 0 if success, 1 if failed
+typedef int (*AdbcLeafDecoder)(ErlNifEnv *env, const AdbcDecoderPlanNode * node, struct ArrowArray * values, int64_t offset, int64_t count, const AdbcMaterializeOptions * options, ERL_NIF_TERM tail, ERL_NIF_TERM &out, ERL_NIF_TERM &error);
+
+/// One node of a decoder plan, it mirrors one ArrowSchema of the stream
+struct AdbcDecoderPlanNode {
+    std::string format;
+
+    // both terms live in the env of the plan
+    ERL_NIF_TERM name;
+    ERL_NIF_TERM metadata;
+
+    // set for leaf types that can be decoded without going
+    // through the format string again
+    AdbcLeafDecoder decode = nullptr;
+    // type of the column, it lives in the env of the plan,
+    // only valid when `decode` is set
+    ERL_NIF_TERM type;
+    // expected value of `ArrowArray.n_buffers`, only valid when `decode` is set,
+    // views have `n_buffers` or more buffers
+    int64_t n_buffers = 0;
+    bool variadic_buffers = false;
+
+    // parsed from `format` for the leaf decoders that need them, the size of
+    // a fixed-size binary or decimal value, and the scale of a decimal
+    int64_t byte_width = 0;
+    int scale = 0;
+
+    // `%Adbc.Column{}` with `data: nil`, only set for the columns of the stream
+    // (the children of the root node), it lives in the env of the plan
+    ERL_NIF_TERM column_template = 0;
+
+    std::vector<AdbcDecoderPlanNode> children;
+    std::unique_ptr<AdbcDecoderPlanNode> dictionary;
+
+    /// @return true if `decode` can decode an ArrowArray with `n` buffers
+    bool accepts_n_buffers(int64_t n) const {
+        return variadic_buffers ? n >= n_buffers : n == n_buffers;
+    }
+};
+
+/// Nodes are passed down along with the schemas they decode, these return
+/// the node of a child or of the dictionary of the schema that `node` decodes
+///
+/// @return nullptr if `node` is nullptr or has no such child
+static inline const AdbcDecoderPlanNode * arrow_decoder_plan_child(const AdbcDecoderPlanNode * node, int64_t child_i) {
+    if (node == nullptr || child_i < 0 || child_i >= (int64_t)node->children.size()) return nullptr;
+    return &node->children[child_i];
+}
+
+static inline const AdbcDecoderPlanNode * arrow_decoder_plan_dictionary(const AdbcDecoderPlanNode * node) {
+    return node ? node->dictionary.get() : nullptr;
+}
+
+/// A decoder plan is built once per ArrowArrayStream from its schema
+/// and shared by all records of the stream.
+///
+/// It's held in a `NifRes<AdbcDecoderPlan>` so that records can keep it
+/// alive after the stream is gone. The plan owns the schema of the stream,
+/// and each record borrows the child schema of its column from it.
+struct AdbcDecoderPlan {
+    struct ArrowSchema schema;
+
+    // process independent env that owns the terms in the plan
+    ErlNifEnv * env;
+    // nullptr if the plan cannot be built for `schema`
+    AdbcDecoderPlanNode * root;
+    // true if every child of `root` has its `column_template`
+    bool has_column_templates;
+
+    void release() {
+        if (this->root) {
+            delete this->root;
+            this->root = nullptr;
+        }
+        if (this->env) {
+            enif_free_env(this->env);
+            this->env = nullptr;
+        }
+        if (this->schema.release) {
+            this->schema.release(&this->schema);
+        }
+    }
+};
+
+#endif  // ADBC_DECODER_PLAN_HPP
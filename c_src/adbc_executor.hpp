@@ -0,0 +1,118 @@
+#ifndef ADBC_EXECUTOR_HPP
+#define ADBC_EXECUTOR_HPP
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <erl_nif.h>
+
+/// A fixed-size pool of native threads that runs blocking ADBC calls
+/// so that they don't hold a dirty scheduler while the database works,
+/// a second pool helps materializing results.
+///
+/// Jobs are run in the order they are submitted, and are given `true` if
+/// the executor is being stopped before they could start, so that they
+/// can still report to the calling process without doing their work.
+///
+/// The threads are detached, `stop` only signals them, so that unloading
+/// the module does not wait for the queries that are still running. Each
+/// thread holds a reference to the executor, which is freed by the last one
+/// to exit, and a running job keeps the resources it uses, see `adbc_run_async`.
+struct AdbcExecutor {
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+    size_t n_threads = 0;
+
+    // guarded by `mutex`
+    std::deque<std::function<void(bool)>> jobs;
+    bool stop = false;
+
+    /// @return nullptr if failed
+    static AdbcExecutor * create(size_t n_threads) {
+        auto executor = new AdbcExecutor();
+        char mutex_name[] = "adbc_executor_mutex";
+        char cond_name[] = "adbc_executor_cond";
+        executor->mutex = enif_mutex_create(mutex_name);
+        executor->cond = enif_cond_create(cond_name);
+        if (executor->mutex == nullptr || executor->cond == nullptr) {
+            executor->release();
+            return nullptr;
+        }
+
+        for (size_t thread_i = 0; thread_i < n_threads; thread_i++) {
+            executor->refs++;
+            try {
+                std::thread(AdbcExecutor::run, executor).detach();
+            } catch (const std::system_error &) {
+                executor->refs--;
+                break;
+            }
+            executor->n_threads++;
+        }
+        if (executor->n_threads == 0) {
+            executor->release();
+            return nullptr;
+        }
+        return executor;
+    }
+
+    /// Cancels the pending jobs and lets the running ones finish on their own,
+    /// `executor` must not be used afterwards
+    static void stop_and_release(AdbcExecutor * executor) {
+        enif_mutex_lock(executor->mutex);
+        executor->stop = true;
+        enif_cond_broadcast(executor->cond);
+        enif_mutex_unlock(executor->mutex);
+        executor->release();
+    }
+
+    void submit(std::function<void(bool)> job) {
+        enif_mutex_lock(this->mutex);
+        this->jobs.emplace_back(std::move(job));
+        enif_cond_signal(this->cond);
+        enif_mutex_unlock(this->mutex);
+    }
+
+private:
+    // one for the owner, one for each running thread
+    std::atomic<int> refs{1};
+
+    void release() {
+        if (--this->refs > 0) {
+            return;
+        }
+        if (this->cond) {
+            enif_cond_destroy(this->cond);
+        }
+        if (this->mutex) {
+            enif_mutex_destroy(this->mutex);
+        }
+        delete this;
+    }
+
+    static void run(AdbcExecutor * self) {
+        enif_mutex_lock(self->mutex);
+        while (true) {
+            while (!self->stop && self->jobs.empty()) {
+                enif_cond_wait(self->cond, self->mutex);
+            }
+            if (self->jobs.empty()) {
+                break;
+            }
+
+            auto job = std::move(self->jobs.front());
+            self->jobs.pop_front();
+            bool cancelled = self->stop;
+            enif_mutex_unlock(self->mutex);
+            job(cancelled);
+            enif_mutex_lock(self->mutex);
+        }
+        enif_mutex_unlock(self->mutex);
+        self->release();
+    }
+};
+
+#endif  // ADBC_EXECUTOR_HPP
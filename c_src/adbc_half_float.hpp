@@ -1,9 +1,24 @@
 #ifndef ADBC_HALF_FLOAT_HPP
+#define ADBC_HALF_FLOAT_HPP
 #pragma once
 
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ADBC_HALF_FLOAT_F16C 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__)
+#define ADBC_HALF_FLOAT_NEON 1
+#include <arm_neon.h>
+#endif
 
 // Function to convert float16 (IEEE 754 half-precision) to float
 float float16_to_float(uint16_t value) {
@@ -44,39 +59,169 @@ float float16_to_float(uint16_t value) {
 }
 
 // Function to convert float to float16 (IEEE 754 half-precision)
+//
+// Rounds to nearest, ties to even, like the F16C and NEON instructions
+// do, so that the batch conversions below give the same results on every CPU.
 uint16_t float_to_float16(float value) {
     static_assert(std::numeric_limits<float>::is_iec559, "IEEE 754 required");
 
     uint32_t fbits;
     memcpy(&fbits, &value, sizeof(fbits));
-    
-    uint16_t sign = (fbits >> 16) & 0x8000;   // sign bit
-    int16_t exp = ((fbits >> 23) & 0xFF) - 127 + 15; // exponent
-    uint32_t mant = fbits & 0x007FFFFF;  // mantissa
-    
-    if (exp <= 0) {
-        if (exp < -10) {
-            // Too small to be represented as a normalized float16
+
+    uint16_t sign = (fbits >> 16) & 0x8000;
+    uint32_t abs = fbits & 0x7FFFFFFF;
+
+    if (abs >= 0x7F800000) {
+        // Infinity, or NaN which stays a (quiet) NaN
+        return sign | 0x7C00 | (abs > 0x7F800000 ? (0x200 | ((abs >> 13) & 0x3FF)) : 0);
+    }
+    if (abs >= 0x477FF000) {
+        // 65520 and above round to infinity
+        return sign | 0x7C00;
+    }
+    if (abs < 0x38800000) {
+        // Below the smallest normalized half-precision number (2^-14)
+        if (abs < 0x33000000) {
+            // Below 2^-25, rounds to zero
             return sign;
         }
-        // Denormalized half-precision
-        mant = (mant | 0x00800000) >> (1 - exp);
-        return sign | (mant >> 13);
-    } else if (exp == 0xFF - (127 - 15)) {
-        if (mant == 0) {
-            // Infinity
-            return sign | 0x7C00;
-        } else {
-            // NaN
-            return sign | 0x7C00 | (mant >> 13);
+        uint32_t exp = abs >> 23;
+        uint32_t mant = (abs & 0x007FFFFF) | 0x00800000;
+        uint32_t shift = 126 - exp;
+        uint32_t half = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (half & 1))) {
+            half++;
         }
-    } else if (exp > 30) {
-        // Overflow to infinity
-        return sign | 0x7C00;
+        return sign | (uint16_t)half;
+    }
+
+    // Normalized half-precision, rounding may carry into the exponent
+    uint32_t half = (abs - 0x38000000) >> 13;
+    uint32_t rem = abs & 0x1FFF;
+    if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) {
+        half++;
+    }
+    return sign | (uint16_t)half;
+}
+
+#if defined(ADBC_HALF_FLOAT_F16C)
+
+#if defined(_MSC_VER)
+#define ADBC_TARGET_F16C
+#else
+#define ADBC_TARGET_F16C __attribute__((target("avx,f16c")))
+#endif
+
+/// @return true if the CPU and the OS support the F16C instructions
+/// together with the AVX registers they use
+static bool half_float_cpu_has_f16c() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    unsigned int ecx = (unsigned int)info[2];
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+#endif
+    bool osxsave = ecx & (1u << 27);
+    bool avx = ecx & (1u << 28);
+    bool f16c = ecx & (1u << 29);
+    if (!(osxsave && avx && f16c)) {
+        return false;
+    }
+#if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    unsigned long long xcr0 = xcr0_lo;
+#endif
+    // the OS saves the XMM and YMM registers
+    return (xcr0 & 0x6) == 0x6;
+}
+
+ADBC_TARGET_F16C static int64_t float16_to_float_f16c(const uint16_t * in, float * out, int64_t count) {
+    int64_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i halfs = _mm_loadu_si128((const __m128i *)(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(halfs));
+    }
+    return i;
+}
+
+ADBC_TARGET_F16C static int64_t float_to_float16_f16c(const float * in, uint16_t * out, int64_t count) {
+    int64_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 floats = _mm256_loadu_ps(in + i);
+        _mm_storeu_si128((__m128i *)(out + i), _mm256_cvtps_ph(floats, _MM_FROUND_TO_NEAREST_INT));
+    }
+    return i;
+}
+
+#elif defined(ADBC_HALF_FLOAT_NEON)
+
+// half-precision conversions are part of the base AArch64 instruction set
+
+static int64_t float16_to_float_neon(const uint16_t * in, float * out, int64_t count) {
+    int64_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t halfs = vreinterpret_f16_u16(vld1_u16(in + i));
+        vst1q_f32(out + i, vcvt_f32_f16(halfs));
+    }
+    return i;
+}
+
+static int64_t float_to_float16_neon(const float * in, uint16_t * out, int64_t count) {
+    int64_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t halfs = vcvt_f16_f32(vld1q_f32(in + i));
+        vst1_u16(out + i, vreinterpret_u16_f16(halfs));
+    }
+    return i;
+}
+
+#endif
+
+/// Converts `count` half-precision values to single precision.
+///
+/// Uses F16C on x86-64 when the CPU has it and NEON on AArch64, 8 and 4
+/// values at a time respectively, and `float16_to_float` for the rest.
+static void float16_to_float_batch(const uint16_t * in, float * out, int64_t count) {
+    int64_t done = 0;
+#if defined(ADBC_HALF_FLOAT_F16C)
+    static const bool has_f16c = half_float_cpu_has_f16c();
+    if (has_f16c) {
+        done = float16_to_float_f16c(in, out, count);
+    }
+#elif defined(ADBC_HALF_FLOAT_NEON)
+    done = float16_to_float_neon(in, out, count);
+#endif
+    for (int64_t i = done; i < count; i++) {
+        out[i] = float16_to_float(in[i]);
+    }
+}
+
+/// Converts `count` single-precision values to half precision,
+/// rounding to nearest, ties to even.
+///
+/// Dispatched like `float16_to_float_batch`.
+static void float_to_float16_batch(const float * in, uint16_t * out, int64_t count) {
+    int64_t done = 0;
+#if defined(ADBC_HALF_FLOAT_F16C)
+    static const bool has_f16c = half_float_cpu_has_f16c();
+    if (has_f16c) {
+        done = float_to_float16_f16c(in, out, count);
+    }
+#elif defined(ADBC_HALF_FLOAT_NEON)
+    done = float_to_float16_neon(in, out, count);
+#endif
+    for (int64_t i = done; i < count; i++) {
+        out[i] = float_to_float16(in[i]);
     }
-    
-    // Normalized half-precision
-    return sign | (exp << 10) | (mant >> 13);
 }
 
 #endif  // ADBC_HALF_FLOAT_HPP
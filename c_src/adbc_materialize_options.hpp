@@ -0,0 +1,156 @@
+#ifndef ADBC_MATERIALIZE_OPTIONS_HPP
+#define ADBC_MATERIALIZE_OPTIONS_HPP
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <erl_nif.h>
+#include "adbc_consts.h"
+#include "adbc_decoder_plan.hpp"
+#include "adbc_string_interner.hpp"
+
+struct AdbcMaterializeOptions {
+    // the resource object that owns the ArrowArray being materialized
+    //
+    // binaries created in zero-copy mode reference this resource,
+    // so the Arrow buffers stay alive as long as any of them does
+    void * owner = nullptr;
+
+    // return string and binary values as sub-binaries of the
+    // Arrow data buffer instead of copying each of them
+    bool zero_copy = false;
+
+    // return primitive, date, time, timestamp and duration columns as one
+    // little-endian binary plus a validity bitmap instead of a list
+    bool packed = false;
+
+    // return dictionary-encoded columns as the list of the values their
+    // indices point at, each dictionary is decoded only once, see `dictionaries`
+    bool expand_dictionary = false;
+
+    // return list view and run-end encoded columns as the list of their
+    // rows, it implies `expand_dictionary`
+    bool expand = false;
+
+    // return the same binary for the string and binary values that repeat
+    // within the records decoded by one call, see `interner`
+    bool intern_strings = false;
+
+    // return map columns as the list of their rows, each row as an Elixir map
+    bool maps = false;
+
+    // what to do with a key that appears more than once in a row with `maps`
+    enum DuplicateKeys {
+        // keep the value of its last entry
+        kDuplicateKeysLast,
+        // keep the value of its first entry
+        kDuplicateKeysFirst,
+        // fail the materialization
+        kDuplicateKeysError,
+    };
+    DuplicateKeys duplicate_keys = kDuplicateKeysLast;
+
+    // the values of a dictionary decoded with `expand_dictionary`, and their type
+    struct ExpandedDictionary {
+        std::vector<ERL_NIF_TERM> values;
+        ERL_NIF_TERM type;
+    };
+    // dictionaries decoded so far, keyed by their array, so that a dictionary
+    // shared by the rows of a list column is decoded once, not once per row
+    //
+    // the terms live in the env of the materialization, so the options
+    // must not be used with another env while this is not empty
+    mutable std::unordered_map<const struct ArrowArray *, ExpandedDictionary> dictionaries;
+
+    // used with `intern_strings`, it's shared by all slices and records of the
+    // call so that the values that repeat across them are interned too
+    //
+    // like `dictionaries`, its terms live in the env of the materialization
+    mutable AdbcStringInterner interner;
+
+    /// Read options from the map given by `Adbc.Column.materialize/2`
+    /// @return 0 if success, 1 if failed
+    static int from_term(ErlNifEnv *env, ERL_NIF_TERM term, AdbcMaterializeOptions &out);
+
+    /// Forget the terms kept by `dictionaries` and `interner`, it must be
+    /// called before options that outlive a call are used by the next one
+    void clear_terms() const {
+        dictionaries.clear();
+        interner = AdbcStringInterner();
+    }
+};
+
+/// Kept across the calls that a column materialization is rescheduled
+/// into, in a `NifRes<AdbcMaterializeState>`, so that its options are
+/// only read from the map given by the caller once
+struct AdbcMaterializeState {
+    AdbcMaterializeOptions * options;
+
+    void release() {
+        if (this->options) {
+            delete this->options;
+            this->options = nullptr;
+        }
+    }
+};
+
+int AdbcMaterializeOptions::from_term(ErlNifEnv *env, ERL_NIF_TERM term, AdbcMaterializeOptions &out) {
+    if (!enif_is_map(env, term)) {
+        return 1;
+    }
+
+    ERL_NIF_TERM value;
+    if (enif_get_map_value(env, term, kAtomZeroCopy, &value)) {
+        out.zero_copy = enif_is_identical(value, kAtomTrue);
+    }
+    if (enif_get_map_value(env, term, kAtomPacked, &value)) {
+        out.packed = enif_is_identical(value, kAtomTrue);
+    }
+    if (enif_get_map_value(env, term, kAtomExpandDictionary, &value)) {
+        out.expand_dictionary = enif_is_identical(value, kAtomTrue);
+    }
+    if (enif_get_map_value(env, term, kAtomExpand, &value)) {
+        out.expand = enif_is_identical(value, kAtomTrue);
+        out.expand_dictionary = out.expand_dictionary || out.expand;
+    }
+    if (enif_get_map_value(env, term, kAtomInternStrings, &value)) {
+        out.intern_strings = enif_is_identical(value, kAtomTrue);
+    }
+    if (enif_get_map_value(env, term, kAtomMaps, &value)) {
+        out.maps = enif_is_identical(value, kAtomTrue);
+    }
+    if (enif_get_map_value(env, term, kAtomDuplicateKeys, &value)) {
+        if (enif_is_identical(value, kAtomLast)) {
+            out.duplicate_keys = kDuplicateKeysLast;
+        } else if (enif_is_identical(value, kAtomFirst)) {
+            out.duplicate_keys = kDuplicateKeysFirst;
+        } else if (enif_is_identical(value, kAtomError)) {
+            out.duplicate_keys = kDuplicateKeysError;
+        } else {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/// Wraps `nbytes` bytes at `data` as a binary without copying them.
+///
+/// The returned binary holds a reference to `options->owner`, and sub-binaries
+/// of it can be made with `enif_make_sub_binary`.
+///
+/// @return true if the binary is created, false if zero-copy is not enabled
+/// or there is nothing to reference, in which case the caller should copy.
+static bool make_zero_copy_binary(ErlNifEnv *env, const AdbcMaterializeOptions * options, const uint8_t * data, size_t nbytes, ERL_NIF_TERM &out) {
+    if (options == nullptr || !options->zero_copy || options->owner == nullptr) {
+        return false;
+    }
+    if (data == nullptr || nbytes == 0) {
+        return false;
+    }
+
+    out = enif_make_resource_binary(env, options->owner, data, nbytes);
+    return true;
+}
+
+#endif  // ADBC_MATERIALIZE_OPTIONS_HPP
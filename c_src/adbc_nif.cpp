@@ -1,6 +1,9 @@
 #include <cstdbool>
 #include <cstdio>
 #include <climits>
+#include <atomic>
+#include <memory>
+#include <utility>
 #include <arrow-adbc/adbc.h>
 #include <erl_nif.h>
 #include <nanoarrow/nanoarrow.h>
@@ -10,6 +13,8 @@
 #include "adbc_column.hpp"
 #include "adbc_arrow_schema.hpp"
 #include "adbc_arrow_array.hpp"
+#include "adbc_arrow_array_packed.hpp"
+#include "adbc_executor.hpp"
 
 template<> ErlNifResourceType * NifRes<struct AdbcDatabase>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct AdbcConnection>::type = nullptr;
@@ -17,6 +22,8 @@ template<> ErlNifResourceType * NifRes<struct AdbcStatement>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct AdbcError>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct ArrowArrayStream>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct ArrowArrayStreamRecord>::type = nullptr;
+template<> ErlNifResourceType * NifRes<struct AdbcDecoderPlan>::type = nullptr;
+template<> ErlNifResourceType * NifRes<struct AdbcMaterializeState>::type = nullptr;
 
 static ERL_NIF_TERM nif_error_from_adbc_error(ErlNifEnv *env, struct AdbcError * adbc_error) {
     char const* message = (adbc_error->message == nullptr) ? "unknown error" : adbc_error->message;
@@ -34,6 +41,51 @@ static ERL_NIF_TERM nif_error_from_adbc_error(ErlNifEnv *env, struct AdbcError *
     return nif_error;
 }
 
+// number of threads of the executor when it's not given at load time
+constexpr int kAdbcExecutorDefaultThreads = 16;
+static AdbcExecutor * adbc_executor = nullptr;
+// helps adbc_result_materialize, one thread less than the schedulers
+// as the calling thread decodes records too, nullptr if there is only one
+static AdbcExecutor * adbc_materialize_executor = nullptr;
+// number of loaded instances of the module that share the executors,
+// an upgrade loads a new one before the old one is unloaded
+static int adbc_executor_users = 0;
+
+/// Runs `job` on the executor and sends `{ref, result}` to the calling process
+/// once it's done, `result` is the term that `job` builds in the env it's given.
+///
+/// `resources` are kept alive until `job` has finished.
+template <typename Job>
+static ERL_NIF_TERM adbc_run_async(ErlNifEnv *env, ERL_NIF_TERM ref, std::vector<void *> resources, Job job) {
+    if (!enif_is_ref(env, ref)) {
+        return enif_make_badarg(env);
+    }
+    if (adbc_executor == nullptr) {
+        return erlang::nif::error(env, "the executor is not running");
+    }
+
+    ErlNifPid caller;
+    enif_self(env, &caller);
+    ErlNifEnv * msg_env = enif_alloc_env();
+    if (msg_env == nullptr) {
+        return erlang::nif::error(env, "out of memory");
+    }
+    ERL_NIF_TERM msg_ref = enif_make_copy(msg_env, ref);
+    for (auto resource : resources) {
+        enif_keep_resource(resource);
+    }
+
+    adbc_executor->submit([caller, msg_env, msg_ref, resources, job](bool cancelled) {
+        ERL_NIF_TERM result = cancelled ? erlang::nif::error(msg_env, "the executor was stopped") : job(msg_env);
+        enif_send(nullptr, &caller, msg_env, enif_make_tuple2(msg_env, msg_ref, result));
+        enif_free_env(msg_env);
+        for (auto resource : resources) {
+            enif_release_resource(resource);
+        }
+    });
+    return erlang::nif::ok(env);
+}
+
 static ERL_NIF_TERM adbc_database_new(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcDatabase>;
 
@@ -272,6 +324,18 @@ static ERL_NIF_TERM adbc_connection_set_option(ErlNifEnv *env, int argc, const E
     );
 }
 
+static ERL_NIF_TERM adbc_connection_init_result(ErlNifEnv *env, NifRes<struct AdbcConnection> * connection, NifRes<struct AdbcDatabase> * db) {
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcConnectionInit(&connection->val, &db->val, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+
+    connection->private_data = &db->val;
+    enif_keep_resource(&db->val);
+    return erlang::nif::ok(env);
+}
+
 static ERL_NIF_TERM adbc_connection_init(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcConnection>;
     using db_type = NifRes<struct AdbcDatabase>;
@@ -286,15 +350,26 @@ static ERL_NIF_TERM adbc_connection_init(ErlNifEnv *env, int argc, const ERL_NIF
         return error;
     }
 
-    struct AdbcError adbc_error{};
-    AdbcStatusCode code = AdbcConnectionInit(&connection->val, &db->val, &adbc_error);
-    if (code != ADBC_STATUS_OK) {
-        return nif_error_from_adbc_error(env, &adbc_error);
+    return adbc_connection_init_result(env, connection, db);
+}
+
+static ERL_NIF_TERM adbc_connection_init_async(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcConnection>;
+    using db_type = NifRes<struct AdbcDatabase>;
+
+    ERL_NIF_TERM error{};
+    res_type * connection = nullptr;
+    db_type * db = nullptr;
+    if ((connection = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+    if ((db = db_type::get_resource(env, argv[1], error)) == nullptr) {
+        return error;
     }
 
-    connection->private_data = &db->val;
-    enif_keep_resource(&db->val);
-    return erlang::nif::ok(env);
+    return adbc_run_async(env, argv[2], {connection, db}, [connection, db](ErlNifEnv *msg_env) {
+        return adbc_connection_init_result(msg_env, connection, db);
+    });
 }
 
 static ERL_NIF_TERM adbc_connection_get_info(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
@@ -476,60 +551,203 @@ static ERL_NIF_TERM adbc_arrow_array_stream_get_pointer(ErlNifEnv *env, int argc
     return enif_make_uint64(env, reinterpret_cast<uint64_t>(&res->val));
 }
 
+static struct ArrowArrayStreamState * arrow_array_stream_state(NifRes<struct ArrowArrayStream> * res) {
+    if (res->private_data == nullptr) {
+        res->private_data = enif_alloc(sizeof(struct ArrowArrayStreamState));
+        if (res->private_data == nullptr) {
+            return nullptr;
+        }
+        memset(res->private_data, 0, sizeof(struct ArrowArrayStreamState));
+    }
+    return (struct ArrowArrayStreamState *)res->private_data;
+}
+
+/// Builds the decoder plan of the stream the first time it's read
+/// @return 0 if success, 1 if failed
+static int arrow_array_stream_init_plan(ErlNifEnv *env, NifRes<struct ArrowArrayStream> * res, ERL_NIF_TERM &error) {
+    using plan_type = NifRes<struct AdbcDecoderPlan>;
+    struct ArrowArrayStreamState * state = (struct ArrowArrayStreamState *)res->private_data;
+    if (state != nullptr && state->plan_resource != nullptr) {
+        return 0;
+    }
+
+    const char * reason = nullptr;
+    plan_type * plan = plan_type::allocate_resource(env, error);
+    if (plan != nullptr) {
+        int code = res->val.get_schema(&res->val, &plan->val.schema);
+        if (code != 0) {
+            reason = res->val.get_last_error(&res->val);
+            enif_release_resource(plan);
+            plan = nullptr;
+        }
+    } else {
+        reason = "out of memory";
+    }
+
+    if (plan != nullptr) {
+        state = arrow_array_stream_state(res);
+        if (state == nullptr) {
+            reason = "out of memory";
+            enif_release_resource(plan);
+            plan = nullptr;
+        }
+    }
+
+    if (plan == nullptr) {
+        error = erlang::nif::error(env, reason ? reason : "unknown error");
+        return 1;
+    }
+
+    // the decoder plan and the column templates are only an optimization,
+    // records are decoded without them if they cannot be built
+    if (arrow_decoder_plan_init(plan->val) == 0) {
+        arrow_decoder_plan_build_column_templates(plan->val);
+    }
+    state->plan_resource = plan;
+    return 0;
+}
+
+/// Gets the next batch of the stream, from the prefetch queue if it has one
+///
+/// If no prefetched batch is available yet and `notify_pid` is not nullptr,
+/// that process is sent `{:adbc_stream_ready, tag}` once there is one.
+///
+/// @return 0 if success, `array->release` is nullptr at the end of the stream,
+///         1 if failed, 2 if no prefetched batch is available yet
+static int arrow_array_stream_next_batch(ErlNifEnv *env, NifRes<struct ArrowArrayStream> * res, struct ArrowArrayStreamState * state, struct ArrowArray * array, ErlNifPid * notify_pid, ERL_NIF_TERM &error) {
+    if (state != nullptr && state->prefetch != nullptr) {
+        std::string reason;
+        int code = state->prefetch->pop(array, notify_pid, reason);
+        if (code == 1) {
+            error = erlang::nif::error(env, reason.c_str());
+        }
+        return code;
+    }
+
+    int code = res->val.get_next(&res->val, array);
+    if (code != 0) {
+        const char * reason = res->val.get_last_error(&res->val);
+        error = erlang::nif::error(env, reason ? reason : "unknown error: cannot get next record with record->val.values");
+        return 1;
+    }
+    return 0;
+}
+
 static ERL_NIF_TERM adbc_arrow_array_stream_next(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct ArrowArrayStream>;
     ERL_NIF_TERM error{};
 
     res_type * res = nullptr;
-    struct ArrowSchema * schema = nullptr;
+    struct ArrowArrayStreamState * state = nullptr;
     struct ArrowArray array{};
     std::vector<ERL_NIF_TERM> out_terms;
 
     if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
         return error;
     }
-    if (res->val.get_next == nullptr) {
+    state = (struct ArrowArrayStreamState *)res->private_data;
+    // a prefetched stream is moved into its prefetch
+    if (res->val.get_next == nullptr && (state == nullptr || state->prefetch == nullptr)) {
         return enif_make_badarg(env);
     }
+    if (state != nullptr && state->ended) {
+        return kAtomEndOfSeries;
+    }
 
-    int code = res->val.get_next(&res->val, &array);
-    if (code != 0) {
-        const char * reason = res->val.get_last_error(&res->val);
-        return erlang::nif::error(env, reason ? reason : "unknown error: cannot get next record with record->val.values");
+    // only build the decoder plan once for the entire stream, before
+    // any batch is prefetched as the stream is not thread-safe
+    if (arrow_array_stream_init_plan(env, res, error) != 0) {
+        return error;
+    }
+    state = (struct ArrowArrayStreamState *)res->private_data;
+    if (state->prefetch_depth > 0 && state->prefetch == nullptr) {
+        // reading is done synchronously if the thread cannot be started
+        state->prefetch = ArrowArrayStreamPrefetch::start(&res->val, (size_t)state->prefetch_depth);
+        if (state->prefetch == nullptr) {
+            state->prefetch_depth = 0;
+        }
+    }
+
+    ErlNifPid self;
+    int code = 0;
+    if (state->pending.release != nullptr) {
+        array = state->pending;
+        state->pending.release = nullptr;
+    } else {
+        code = arrow_array_stream_next_batch(env, res, state, &array, enif_self(env, &self), error);
+    }
+    if (code == 1) {
+        return error;
+    }
+    if (code == 2) {
+        return enif_make_tuple2(env, kAtomPending, enif_make_uint64(env, state->prefetch->tag));
     }
     // if no error and the array is released, the stream has ended
     if (array.release == nullptr) {
         return kAtomEndOfSeries;
     }
 
-    // only allocate priv data once for the entire stream
-    if (res->private_data == nullptr) {
-        const char * reason = nullptr;
-        res->private_data = enif_alloc(sizeof(struct ArrowSchema));
-        if (res->private_data != nullptr) {
-            memset(res->private_data, 0, sizeof(struct ArrowSchema));
-            code = res->val.get_schema(&res->val, (struct ArrowSchema *)res->private_data);
-        } else {
-            reason = "out of memory";
-        }
-
-        // if `res->private_data` was null, `code` will still be 0
-        if (code != 0) {
-            reason = res->val.get_last_error(&res->val);
-            enif_free(res->private_data);
-            res->private_data = nullptr;
-        }
-
-        if (res->private_data == nullptr) {
-            error = erlang::nif::error(env, reason ? reason : "unknown error");
+    auto plan = (NifRes<struct AdbcDecoderPlan> *)state->plan_resource;
+    ERL_NIF_TERM columns{};
+    if (plan->val.has_column_templates) {
+        // read driver batches until the rebatch target is reached, the
+        // records of all batches are returned in one call, but each batch
+        // keeps its own records, they are not concatenated
+        //
+        // batches are not split: one that would exceed the target is kept
+        // for the next call, unless it is the first one of this call
+        bool rebatch = state->target_rows > 0 || state->target_bytes > 0;
+        std::vector<std::vector<ERL_NIF_TERM>> refs;
+        int64_t batches = 0;
+        int64_t rows = 0;
+        int64_t bytes = 0;
+        while (true) {
+            int64_t array_bytes = 0;
+            if (state->target_bytes > 0) {
+                array_bytes = arrow_array_estimate_bytes(&plan->val.schema, &array);
+            }
+            if (batches > 0 &&
+                ((state->target_rows > 0 && rows + array.length > state->target_rows) ||
+                 (state->target_bytes > 0 && bytes + array_bytes > state->target_bytes))) {
+                state->pending = array;
+                break;
+            }
+            batches++;
+            rows += array.length;
+            bytes += array_bytes;
+            code = arrow_array_to_column_refs_from_plan(env, state->plan_resource, &array, refs, error);
             if (array.release) {
                 array.release(&array);
             }
-            return error;
+            if (code != 0) {
+                return error;
+            }
+
+            if (!rebatch) break;
+            if (state->target_rows > 0 && rows >= state->target_rows) break;
+            if (state->target_bytes > 0 && bytes >= state->target_bytes) break;
+
+            // don't wait for batches that are still being prefetched
+            code = arrow_array_stream_next_batch(env, res, state, &array, nullptr, error);
+            if (code == 1) {
+                return error;
+            }
+            if (code == 2) {
+                break;
+            }
+            if (array.release == nullptr) {
+                state->ended = true;
+                break;
+            }
         }
+        columns = arrow_columns_from_plan(env, state->plan_resource, refs);
+        return erlang::nif::ok(env, columns);
+    }
+
+    code = arrow_schema_to_nif_term(env, &plan->val.schema, &array, out_terms, error, state->plan_resource);
+    if (code == 0) {
+        columns = out_terms[0];
     }
-    schema = (struct ArrowSchema *)res->private_data;
-    code = arrow_schema_to_nif_term(env, schema, &array, out_terms, error);
     // the outter array should be released because we have moved the values
     // for each column to the corresponding reference in `Adbc.Column.data`
     if (array.release) {
@@ -542,66 +760,805 @@ static ERL_NIF_TERM adbc_arrow_array_stream_next(ErlNifEnv *env, int argc, const
         // it will be released when the stream resource is GC'd
         return error;
     } else {
-        return erlang::nif::ok(env, out_terms[0]);
+        return erlang::nif::ok(env, columns);
     }
 }
 
-static ERL_NIF_TERM adbc_column_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    using record_type = NifRes<struct ArrowArrayStreamRecord>;
-    record_type * res = nullptr;
+static ERL_NIF_TERM adbc_arrow_array_stream_set_rebatch(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct ArrowArrayStream>;
+    ERL_NIF_TERM error{};
 
-    std::vector<ERL_NIF_TERM> data_ref;
-    if (enif_is_ref(env, argv[0])) {
-        data_ref.emplace_back(argv[0]);
-    } else if (enif_is_list(env, argv[0])) {
+    res_type * res = nullptr;
+    if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    ErlNifSInt64 target_rows = 0;
+    ErlNifSInt64 target_bytes = 0;
+    if (!enif_get_int64(env, argv[1], &target_rows) || target_rows < 0) {
+        return enif_make_badarg(env);
+    }
+    if (!enif_get_int64(env, argv[2], &target_bytes) || target_bytes < 0) {
+        return enif_make_badarg(env);
+    }
+
+    struct ArrowArrayStreamState * state = arrow_array_stream_state(res);
+    if (state == nullptr) {
+        return erlang::nif::error(env, "out of memory");
+    }
+    state->target_rows = target_rows;
+    state->target_bytes = target_bytes;
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_arrow_array_stream_set_prefetch(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct ArrowArrayStream>;
+    ERL_NIF_TERM error{};
+
+    res_type * res = nullptr;
+    if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    ErlNifSInt64 depth = 0;
+    if (!enif_get_int64(env, argv[1], &depth) || depth < 0) {
+        return enif_make_badarg(env);
+    }
+
+    struct ArrowArrayStreamState * state = arrow_array_stream_state(res);
+    if (state == nullptr) {
+        return erlang::nif::error(env, "out of memory");
+    }
+    if (state->prefetch != nullptr) {
+        return erlang::nif::error(env, "the stream is already being prefetched");
+    }
+    state->prefetch_depth = depth;
+    return erlang::nif::ok(env);
+}
+
+// number of rows decoded at once when a column is materialized in slices
+constexpr int64_t kMaterializeSliceRows = 16384;
+// number of bytes of string or binary values decoded at once
+// when a column is materialized in slices
+constexpr int64_t kMaterializeSliceBytes = 1048576;
+
+/// Collects the records of the reference or list of references in `data_ref`
+/// @return 0 if success, 1 if failed
+static int adbc_column_materialize_records(ErlNifEnv *env, ERL_NIF_TERM data_ref, std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records, ERL_NIF_TERM &error) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    std::vector<ERL_NIF_TERM> refs;
+    if (enif_is_ref(env, data_ref)) {
+        refs.emplace_back(data_ref);
+    } else if (enif_is_list(env, data_ref)) {
         unsigned int length;
-        ERL_NIF_TERM list = argv[0];
+        ERL_NIF_TERM list = data_ref;
         if (!enif_get_list_length(env, list, &length)) {
-            return enif_make_badarg(env);
+            error = enif_make_badarg(env);
+            return 1;
         }
 
+        refs.reserve(length);
         ERL_NIF_TERM head, tail;
         while (enif_get_list_cell(env, list, &head, &tail)) {
             if (!enif_is_ref(env, head)) {
-                return enif_make_badarg(env);
+                error = enif_make_badarg(env);
+                return 1;
             }
-            data_ref.emplace_back(head);
+            refs.emplace_back(head);
             list = tail;
         }
     } else {
+        error = enif_make_badarg(env);
+        return 1;
+    }
+
+    records.reserve(refs.size());
+    for (auto& ref : refs) {
+        record_type * res = nullptr;
+        if ((res = record_type::get_resource(env, ref, error)) == nullptr) {
+            return 1;
+        }
+        if (res->val.schema == nullptr || res->val.values == nullptr) {
+            error = enif_make_badarg(env);
+            return 1;
+        }
+        records.emplace_back(res);
+    }
+    return 0;
+}
+
+/// Decodes `count` rows of a record starting at `start` into a list,
+/// `count` is -1 to decode all of them, and sets `out_type` to the type
+/// of the decoded values.
+///
+/// The record is decoded with the node of its plan, if it has one.
+/// @return 0 if success, 1 if failed
+static int adbc_column_materialize_record(ErlNifEnv *env, NifRes<struct ArrowArrayStreamRecord> * res, int64_t start, int64_t count, const AdbcMaterializeOptions &options, ERL_NIF_TERM &out, ERL_NIF_TERM &out_type, ERL_NIF_TERM &error) {
+    std::vector<ERL_NIF_TERM> out_terms;
+    constexpr int level = 0;
+    ERL_NIF_TERM out_metadata;
+    if (arrow_array_to_nif_term(env, res->val.schema, res->val.values, start, count, level, out_terms, out_type, out_metadata, error, false, &options, res->val.plan_node) != 0) {
+        return 1;
+    }
+    out = out_terms.size() == 1 ? out_terms[0] : out_terms[1];
+    return 0;
+}
+
+/// @return true if the dictionary-encoded records of a column
+/// are expanded into the values of their dictionary
+static bool adbc_column_is_expanded(const std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records, const AdbcMaterializeOptions &options) {
+    if (!options.expand_dictionary || records.empty()) {
+        return false;
+    }
+    for (auto record : records) {
+        if (record->val.schema->dictionary == nullptr || !arrow_array_is_expandable(record->val.schema, &options)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Returns the values of an expanded dictionary column as
+/// `{:dictionary, value_type, values}`, so that the column
+/// can take the type of the values
+static ERL_NIF_TERM adbc_column_make_expanded(ErlNifEnv *env, ERL_NIF_TERM value_type, ERL_NIF_TERM values) {
+    return enif_make_tuple3(env, kAdbcColumnTypeDictionary, value_type, values);
+}
+
+/// Returns the width of the values of a column made of `records`
+/// if it can be returned in packed mode, 0 otherwise
+static size_t adbc_column_packed_element_size(const std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records) {
+    if (records.empty() || records[0]->val.schema->dictionary != nullptr) {
+        return 0;
+    }
+    const char * format = records[0]->val.schema->format;
+    size_t element_size = arrow_packed_element_size(format);
+    for (auto record : records) {
+        if (element_size == 0 || strcmp(record->val.schema->format, format) != 0) {
+            return 0;
+        }
+    }
+    return element_size;
+}
+
+/// @return true if the column made of `records` is returned in packed mode
+/// without copying, as references to the buffers of its single record
+static bool adbc_column_packed_is_zero_copy(const std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records) {
+    return records.size() == 1 && arrow_packed_is_zero_copy(records[0]->val.values);
+}
+
+/// @return 0 if success, 1 if failed
+static int adbc_column_materialize_packed(ErlNifEnv *env, const std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records, size_t element_size, ERL_NIF_TERM &out, ERL_NIF_TERM &error) {
+    std::vector<struct ArrowArray *> chunks;
+    std::vector<void *> owners;
+    for (auto record : records) {
+        chunks.emplace_back(record->val.values);
+        owners.emplace_back(record);
+    }
+    return arrow_arrays_to_packed_nif_term(env, chunks, owners, element_size, out, error);
+}
+
+template <typename OffsetT> static int64_t adbc_column_slice_start_by_bytes(const OffsetT * offsets, int64_t start, int64_t end) {
+    // the first row from which the values up to `end` fit in the limit
+    int64_t first = std::lower_bound(offsets + start, offsets + end, (int64_t)offsets[end] - kMaterializeSliceBytes) - offsets;
+    // a single value larger than the limit is decoded on its own
+    return first < end ? first : end - 1;
+}
+
+/// Moves `start` forward so that the slice `[start, end)` of a string or
+/// binary record holds at most `kMaterializeSliceBytes` bytes of values,
+/// or at least one row
+static int64_t adbc_column_slice_start(struct ArrowArray * values, const AdbcDecoderPlanNode * plan_node, int64_t start, int64_t end) {
+    if (start >= end || plan_node->n_buffers != 3 || values->buffers[1] == nullptr) {
+        return start;
+    }
+    switch (plan_node->format[0]) {
+        case 'u':
+        case 'z':
+            return adbc_column_slice_start_by_bytes((const int32_t *)values->buffers[1], start, end);
+        case 'U':
+        case 'Z':
+            return adbc_column_slice_start_by_bytes((const int64_t *)values->buffers[1], start, end);
+        default:
+            return start;
+    }
+}
+
+/// Decodes the slice `[start, start + count)` of a record whose plan has
+/// a leaf decoder, and prepends its values to the list `acc`
+/// @return 0 if success, 1 if failed
+static int adbc_column_materialize_slice(ErlNifEnv *env, NifRes<struct ArrowArrayStreamRecord> * res, const AdbcDecoderPlanNode * plan_node, int64_t start, int64_t count, const AdbcMaterializeOptions &options, ERL_NIF_TERM &acc, ERL_NIF_TERM &out_type, ERL_NIF_TERM &error) {
+    if (!plan_node->accepts_n_buffers(res->val.values->n_buffers)) {
+        char err_msg_buf[256] = { '\0' };
+        snprintf(err_msg_buf, sizeof(err_msg_buf), "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != %lld", plan_node->format.c_str(), (long long)plan_node->n_buffers);
+        error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
+        return 1;
+    }
+    if (plan_node->decode(env, plan_node, res->val.values, start, count, &options, acc, acc, error) != 0) {
+        return 1;
+    }
+    out_type = enif_make_copy(env, plan_node->type);
+    return 0;
+}
+
+/// Prepends the elements of `list` to `acc`, `list` is returned
+/// as it is if `acc` is empty
+static ERL_NIF_TERM adbc_column_materialize_prepend(ErlNifEnv *env, ERL_NIF_TERM list, ERL_NIF_TERM acc, std::vector<ERL_NIF_TERM> &scratch) {
+    if (enif_is_empty_list(env, acc)) {
+        return list;
+    }
+    scratch.clear();
+    ERL_NIF_TERM head, tail;
+    while (enif_get_list_cell(env, list, &head, &tail)) {
+        scratch.emplace_back(head);
+        list = tail;
+    }
+    for (auto value = scratch.rbegin(); value != scratch.rend(); ++value) {
+        acc = enif_make_list_cell(env, *value, acc);
+    }
+    return acc;
+}
+
+/// Materializes the records of a column, it's rescheduled with
+/// `enif_schedule_nif` until the whole column has been decoded.
+///
+/// The records are decoded from the last one to the first one, and records
+/// with a leaf decoder in their plan are decoded in slices of at most
+/// `kMaterializeSliceRows` rows and `kMaterializeSliceBytes` bytes, also
+/// from the end, and the leaf decoder conses the values of every slice onto
+/// the list of values decoded so far, so that each cell is made once.
+/// Other records are decoded whole on a dirty scheduler.
+///
+/// argv: `[data_ref, state, records_left, slice_end, acc]`, where `state` is
+/// the `NifRes<AdbcMaterializeState>` with the parsed options, the record
+/// being decoded is `records_left - 1` and `slice_end` is the end of the
+/// rows left in it, or -1 if none of its rows have been decoded yet.
+static ERL_NIF_TERM adbc_column_materialize_slices(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    using state_type = NifRes<struct AdbcMaterializeState>;
+    ERL_NIF_TERM error{};
+
+    std::vector<record_type *> records;
+    if (adbc_column_materialize_records(env, argv[0], records, error) != 0) {
+        return error;
+    }
+    state_type * state = state_type::get_resource(env, argv[1], error);
+    if (state == nullptr) {
+        return error;
+    }
+    // the terms cached by the previous call are not valid in this one
+    AdbcMaterializeOptions &options = *state->val.options;
+    options.clear_terms();
+
+    ErlNifSInt64 records_left = 0;
+    ErlNifSInt64 slice_end = 0;
+    if (!enif_get_int64(env, argv[2], &records_left) || records_left < 0 || records_left > (ErlNifSInt64)records.size()) {
         return enif_make_badarg(env);
     }
+    if (!enif_get_int64(env, argv[3], &slice_end)) {
+        return enif_make_badarg(env);
+    }
+    ERL_NIF_TERM materialized = argv[4];
+    ERL_NIF_TERM value_type = kAtomNil;
+    bool is_dirty = enif_thread_type() != ERL_NIF_THR_NORMAL_SCHEDULER;
+
+    std::vector<ERL_NIF_TERM> scratch;
+    while (records_left > 0) {
+        record_type * res = records[records_left - 1];
+        options.owner = res;
+
+        const AdbcDecoderPlanNode * plan_node = res->val.plan_node;
+        bool can_slice = plan_node != nullptr && plan_node->decode != nullptr && res->val.schema->dictionary == nullptr;
+        int64_t length = res->val.values->length;
+        if (!can_slice && !is_dirty) {
+            // nested records cannot be decoded in bounded steps
+            ERL_NIF_TERM next_argv[] = {argv[0], argv[1], enif_make_int64(env, records_left), enif_make_int64(env, slice_end), materialized};
+            return enif_schedule_nif(env, "adbc_column_materialize", ERL_NIF_DIRTY_JOB_CPU_BOUND, adbc_column_materialize_slices, 5, next_argv);
+        }
+
+        int64_t start = 0;
+        int64_t count = -1;
+        if (can_slice) {
+            if (slice_end < 0 || slice_end > length) slice_end = length;
+            start = slice_end > kMaterializeSliceRows ? slice_end - kMaterializeSliceRows : 0;
+            start = adbc_column_slice_start(res->val.values, plan_node, start, slice_end);
+            count = slice_end - start;
+        }
+
+        ErlNifTime started_at = enif_monotonic_time(ERL_NIF_USEC);
+        if (can_slice) {
+            // the values are consed onto the ones decoded so far directly
+            if (count != 0 && adbc_column_materialize_slice(env, res, plan_node, start, count, options, materialized, value_type, error) != 0) {
+                return error;
+            }
+        } else {
+            ERL_NIF_TERM chunk;
+            if (adbc_column_materialize_record(env, res, start, count, options, chunk, value_type, error) != 0) {
+                return error;
+            }
+            if (!enif_is_list(env, chunk)) {
+                // dictionaries that are not expanded are returned as they are
+                if (records.size() != 1) {
+                    return erlang::nif::error(env, "cannot materialize a dictionary column with more than one chunk, pass expand_dictionary: true to expand it");
+                }
+                return erlang::nif::ok(env, chunk);
+            }
+            materialized = adbc_column_materialize_prepend(env, chunk, materialized, scratch);
+        }
+
+        if (can_slice && start > 0) {
+            slice_end = start;
+        } else {
+            records_left--;
+            slice_end = -1;
+        }
+
+        if (records_left == 0) {
+            break;
+        }
+
+        if (is_dirty) {
+            // the nested record is done, go back to a normal scheduler
+            ERL_NIF_TERM next_argv[] = {argv[0], argv[1], enif_make_int64(env, records_left), enif_make_int64(env, slice_end), materialized};
+            return enif_schedule_nif(env, "adbc_column_materialize", 0, adbc_column_materialize_slices, 5, next_argv);
+        }
+
+        // a timeslice is 1 millisecond
+        int percent = (int)((enif_monotonic_time(ERL_NIF_USEC) - started_at) / 10);
+        if (percent < 1) percent = 1;
+        if (percent > 100) percent = 100;
+        if (enif_consume_timeslice(env, percent)) {
+            ERL_NIF_TERM next_argv[] = {argv[0], argv[1], enif_make_int64(env, records_left), enif_make_int64(env, slice_end), materialized};
+            return enif_schedule_nif(env, "adbc_column_materialize", 0, adbc_column_materialize_slices, 5, next_argv);
+        }
+    }
+
+    // the first record is always decoded by the last call, so its type is known
+    if (adbc_column_is_expanded(records, options)) {
+        materialized = adbc_column_make_expanded(env, value_type, materialized);
+    }
+    return erlang::nif::ok(env, materialized);
+}
+
+static ERL_NIF_TERM adbc_column_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
 
-    std::vector<ERL_NIF_TERM> materialized;
     ERL_NIF_TERM error{};
-    for (auto& ref : data_ref) {
-        if ((res = record_type::get_resource(env, ref, error)) == nullptr) {
+    std::vector<record_type *> records;
+    if (adbc_column_materialize_records(env, argv[0], records, error) != 0) {
+        return error;
+    }
+
+    AdbcMaterializeOptions options;
+    if (AdbcMaterializeOptions::from_term(env, argv[1], options) != 0) {
+        return enif_make_badarg(env);
+    }
+
+    size_t element_size = options.packed ? adbc_column_packed_element_size(records) : 0;
+    if (element_size > 0) {
+        if (!adbc_column_packed_is_zero_copy(records) && enif_thread_type() == ERL_NIF_THR_NORMAL_SCHEDULER) {
+            // the chunks, or the bitmap of an unaligned one, are copied
+            return enif_schedule_nif(env, "adbc_column_materialize", ERL_NIF_DIRTY_JOB_CPU_BOUND, adbc_column_materialize, argc, argv);
+        }
+
+        ERL_NIF_TERM packed;
+        if (adbc_column_materialize_packed(env, records, element_size, packed, error) != 0) {
             return error;
         }
-        if (res->val.schema == nullptr || res->val.values == nullptr) {
-            return enif_make_badarg(env);
+        return erlang::nif::ok(env, packed);
+    }
+
+    using state_type = NifRes<struct AdbcMaterializeState>;
+    state_type * state = state_type::allocate_resource(env, error);
+    if (state == nullptr) {
+        return error;
+    }
+    state->val.options = new AdbcMaterializeOptions(options);
+    ERL_NIF_TERM state_term = state->make_resource(env);
+    enif_release_resource(state);
+
+    ERL_NIF_TERM slices_argv[] = {argv[0], state_term, enif_make_int64(env, (ErlNifSInt64)records.size()), enif_make_int64(env, -1), enif_make_list(env, 0)};
+    return adbc_column_materialize_slices(env, 5, slices_argv);
+}
+
+/// Decodes all records of a column into one list and sets `out_type` to the
+/// type of its values.
+///
+/// The records are decoded from the last one to the first one, and the leaf
+/// decoder of each record conses its values onto those of the records after
+/// it, so that each cell of the list is made once, in `env`. A dictionary
+/// column that is not expanded is returned as it is.
+///
+/// @return 0 if success, 1 if failed
+static int adbc_column_materialize_all(ErlNifEnv *env, const std::vector<NifRes<struct ArrowArrayStreamRecord> *> &records, AdbcMaterializeOptions &options, ERL_NIF_TERM &out, ERL_NIF_TERM &out_type, ERL_NIF_TERM &error) {
+    ERL_NIF_TERM materialized = enif_make_list(env, 0);
+    out_type = kAtomNil;
+    std::vector<ERL_NIF_TERM> scratch;
+    for (size_t record_i = records.size(); record_i > 0; record_i--) {
+        auto res = records[record_i - 1];
+        options.owner = res;
+
+        const AdbcDecoderPlanNode * plan_node = res->val.plan_node;
+        if (plan_node != nullptr && plan_node->decode != nullptr && res->val.schema->dictionary == nullptr) {
+            if (adbc_column_materialize_slice(env, res, plan_node, 0, res->val.values->length, options, materialized, out_type, error) != 0) {
+                return 1;
+            }
+            continue;
+        }
+
+        ERL_NIF_TERM chunk;
+        if (adbc_column_materialize_record(env, res, 0, -1, options, chunk, out_type, error) != 0) {
+            return 1;
+        }
+        if (!enif_is_list(env, chunk)) {
+            // dictionaries that are not expanded are returned as they are
+            if (records.size() != 1) {
+                error = erlang::nif::error(env, "cannot materialize a dictionary column with more than one chunk, pass expand_dictionary: true to expand it");
+                return 1;
+            }
+            out = chunk;
+            return 0;
+        }
+        materialized = adbc_column_materialize_prepend(env, chunk, materialized, scratch);
+    }
+
+    if (adbc_column_is_expanded(records, options)) {
+        materialized = adbc_column_make_expanded(env, out_type, materialized);
+    }
+    out = materialized;
+    return 0;
+}
+
+// results with fewer rows than this are decoded by the calling thread only
+constexpr int64_t kMaterializeParallelRows = 65536;
+
+/// A column to be decoded by adbc_result_materialize
+struct AdbcMaterializeTask {
+    std::vector<NifRes<struct ArrowArrayStreamRecord> *> records;
+    int64_t rows;
+    unsigned int column_i;
+    // the decoded column, it lives in `env`
+    ERL_NIF_TERM values;
+    ErlNifEnv * env;
+};
+
+/// Decodes tasks until there are none left, several workers share
+/// the same tasks and each one takes the next task that nobody has taken
+struct AdbcMaterializeWorker {
+    // the env of the caller for the calling thread,
+    // a process independent env for the others
+    ErlNifEnv * env;
+    std::vector<AdbcMaterializeTask> * tasks;
+    std::atomic<size_t> * next_task;
+    std::atomic<bool> * failed;
+    const AdbcMaterializeOptions * options;
+
+    bool has_error;
+    ERL_NIF_TERM error;
+
+    void run() {
+        // each worker caches terms in its own env
+        AdbcMaterializeOptions worker_options = *this->options;
+        worker_options.clear_terms();
+        while (!this->failed->load()) {
+            size_t task_i = this->next_task->fetch_add(1);
+            if (task_i >= this->tasks->size()) {
+                break;
+            }
+
+            auto &task = (*this->tasks)[task_i];
+            ERL_NIF_TERM type;
+            if (adbc_column_materialize_all(this->env, task.records, worker_options, task.values, type, this->error) != 0) {
+                this->has_error = true;
+                this->failed->store(true);
+                break;
+            }
+            task.env = this->env;
         }
+    }
+
+};
+
+/// Tracks the jobs that adbc_result_materialize submits to the materialize
+/// executor, it's shared with them as they may start after the call returns.
+///
+/// A job only runs its worker if the call has not been closed yet,
+/// and the call waits for the running ones when it's closed.
+struct AdbcMaterializeJobs {
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+
+    // guarded by `mutex`
+    size_t running = 0;
+    bool closed = false;
+
+    /// @return nullptr if failed
+    static std::shared_ptr<AdbcMaterializeJobs> create() {
+        auto jobs = std::make_shared<AdbcMaterializeJobs>();
+        char mutex_name[] = "adbc_materialize_mutex";
+        char cond_name[] = "adbc_materialize_cond";
+        jobs->mutex = enif_mutex_create(mutex_name);
+        jobs->cond = enif_cond_create(cond_name);
+        if (jobs->mutex == nullptr || jobs->cond == nullptr) {
+            return nullptr;
+        }
+        return jobs;
+    }
+
+    ~AdbcMaterializeJobs() {
+        if (this->cond) {
+            enif_cond_destroy(this->cond);
+        }
+        if (this->mutex) {
+            enif_mutex_destroy(this->mutex);
+        }
+    }
+
+    /// @return false if the call has been closed and the job must not run
+    bool enter() {
+        enif_mutex_lock(this->mutex);
+        bool open = !this->closed;
+        if (open) {
+            this->running++;
+        }
+        enif_mutex_unlock(this->mutex);
+        return open;
+    }
+
+    void leave() {
+        enif_mutex_lock(this->mutex);
+        if (--this->running == 0) {
+            enif_cond_broadcast(this->cond);
+        }
+        enif_mutex_unlock(this->mutex);
+    }
+
+    /// Stops the jobs that have not started yet and waits for the others
+    void close() {
+        enif_mutex_lock(this->mutex);
+        this->closed = true;
+        while (this->running > 0) {
+            enif_cond_wait(this->cond, this->mutex);
+        }
+        enif_mutex_unlock(this->mutex);
+    }
+};
+
+static ERL_NIF_TERM adbc_result_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    ERL_NIF_TERM error{};
+
+    unsigned int n_columns = 0;
+    if (!enif_get_list_length(env, argv[0], &n_columns)) {
+        return enif_make_badarg(env);
+    }
+    AdbcMaterializeOptions options;
+    if (AdbcMaterializeOptions::from_term(env, argv[1], options) != 0) {
+        return enif_make_badarg(env);
+    }
+
+    // packed columns are returned right away, the other columns become
+    // tasks, the largest ones first so that they do not start last
+    std::vector<ERL_NIF_TERM> results(n_columns);
+    std::vector<AdbcMaterializeTask> tasks;
+    int64_t total_rows = 0;
 
-        std::vector<ERL_NIF_TERM> out_terms;
-        constexpr int level = 0;
-        ERL_NIF_TERM out_type;
-        ERL_NIF_TERM out_metadata;
-        if (arrow_array_to_nif_term(env, res->val.schema, res->val.values, level, out_terms, out_type, out_metadata, error) != 0) {
+    ERL_NIF_TERM list = argv[0];
+    ERL_NIF_TERM head, tail;
+    for (unsigned int column_i = 0; enif_get_list_cell(env, list, &head, &tail); column_i++, list = tail) {
+        std::vector<record_type *> records;
+        if (adbc_column_materialize_records(env, head, records, error) != 0) {
             return error;
         }
 
-        ERL_NIF_TERM ret{};
-        if (out_terms.size() == 1) {
-            ret = out_terms[0];
-        } else {
-            ret = out_terms[1];
+        size_t element_size = options.packed ? adbc_column_packed_element_size(records) : 0;
+        if (element_size > 0) {
+            if (adbc_column_materialize_packed(env, records, element_size, results[column_i], error) != 0) {
+                return error;
+            }
+            continue;
         }
 
-        materialized.emplace_back(ret);
+        int64_t rows = 0;
+        for (auto record : records) {
+            rows += record->val.values->length;
+        }
+        tasks.push_back({std::move(records), rows, column_i, 0, nullptr});
+        total_rows += rows;
+    }
+    std::stable_sort(tasks.begin(), tasks.end(), [](const AdbcMaterializeTask &a, const AdbcMaterializeTask &b) {
+        return a.rows > b.rows;
+    });
+
+    size_t n_threads = 0;
+    std::shared_ptr<AdbcMaterializeJobs> jobs;
+    if (adbc_materialize_executor != nullptr && tasks.size() > 1 && total_rows >= kMaterializeParallelRows) {
+        jobs = AdbcMaterializeJobs::create();
+        n_threads = jobs ? adbc_materialize_executor->n_threads : 0;
+        if (n_threads > tasks.size() - 1) {
+            n_threads = tasks.size() - 1;
+        }
     }
 
-    ERL_NIF_TERM ret = enif_make_list_from_array(env, materialized.data(), materialized.size());
-    return erlang::nif::ok(env, ret);
+    std::atomic<size_t> next_task{0};
+    std::atomic<bool> failed{false};
+    std::vector<AdbcMaterializeWorker> workers(n_threads + 1);
+    for (auto &worker : workers) {
+        worker.env = nullptr;
+        worker.tasks = &tasks;
+        worker.next_task = &next_task;
+        worker.failed = &failed;
+        worker.options = &options;
+        worker.has_error = false;
+        worker.error = 0;
+    }
+
+    // the calling thread is the first worker, it can use its own env,
+    // the others are run by the materialize executor when it has a free thread
+    workers[0].env = env;
+    size_t n_started = 0;
+    for (size_t worker_i = 1; worker_i < workers.size(); worker_i++) {
+        auto worker = &workers[worker_i];
+        worker->env = enif_alloc_env();
+        if (worker->env == nullptr) {
+            break;
+        }
+        adbc_materialize_executor->submit([jobs, worker](bool cancelled) {
+            if (!cancelled && jobs->enter()) {
+                worker->run();
+                jobs->leave();
+            }
+        });
+        n_started++;
+    }
+    workers[0].run();
+    if (jobs) {
+        jobs->close();
+    }
+
+    ERL_NIF_TERM ret{};
+    bool has_error = false;
+    for (size_t worker_i = 0; worker_i <= n_started; worker_i++) {
+        if (workers[worker_i].has_error) {
+            ret = enif_make_copy(env, workers[worker_i].error);
+            has_error = true;
+            break;
+        }
+    }
+
+    if (!has_error) {
+        // a column decoded by another worker is copied once, as a whole
+        for (auto &task : tasks) {
+            results[task.column_i] = task.env == env ? task.values : enif_make_copy(env, task.values);
+        }
+        ret = erlang::nif::ok(env, enif_make_list_from_array(env, results.data(), (unsigned)results.size()));
+    }
+
+    for (size_t worker_i = 1; worker_i <= n_started; worker_i++) {
+        enif_free_env(workers[worker_i].env);
+    }
+    return ret;
+}
+
+/// Returns rows `[offset, offset + limit)` of a result, `limit` is -1 for all of them.
+///
+/// Each row is a tuple with a value per column, or a map from the given
+/// keys to those values when `keys` is a list instead of nil. The columns
+/// are decoded only for the rows in the window, and the values are put
+/// into the rows directly, without making a list per column first.
+static ERL_NIF_TERM adbc_result_rows(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    ERL_NIF_TERM error{};
+
+    unsigned int n_columns = 0;
+    if (!enif_get_list_length(env, argv[0], &n_columns)) {
+        return enif_make_badarg(env);
+    }
+
+    bool as_maps = !enif_is_identical(argv[1], kAtomNil);
+    std::vector<ERL_NIF_TERM> keys;
+    if (as_maps) {
+        unsigned int n_keys = 0;
+        if (!enif_get_list_length(env, argv[1], &n_keys) || n_keys != n_columns) {
+            return enif_make_badarg(env);
+        }
+        keys.reserve(n_keys);
+        ERL_NIF_TERM head, tail, list = argv[1];
+        while (enif_get_list_cell(env, list, &head, &tail)) {
+            keys.emplace_back(head);
+            list = tail;
+        }
+    }
+
+    ErlNifSInt64 offset = 0;
+    ErlNifSInt64 limit = 0;
+    if (!enif_get_int64(env, argv[2], &offset) || offset < 0) {
+        return enif_make_badarg(env);
+    }
+    if (!enif_get_int64(env, argv[3], &limit) || limit < -1) {
+        return enif_make_badarg(env);
+    }
+
+    AdbcMaterializeOptions options;
+    if (AdbcMaterializeOptions::from_term(env, argv[4], options) != 0) {
+        return enif_make_badarg(env);
+    }
+    // every value becomes an element of a row
+    options.packed = false;
+
+    std::vector<std::vector<record_type *>> columns(n_columns);
+    int64_t n_rows = -1;
+    ERL_NIF_TERM head, tail, list = argv[0];
+    for (unsigned int column_i = 0; enif_get_list_cell(env, list, &head, &tail); column_i++, list = tail) {
+        if (adbc_column_materialize_records(env, head, columns[column_i], error) != 0) {
+            return error;
+        }
+        int64_t column_rows = 0;
+        for (auto record : columns[column_i]) {
+            if (!arrow_array_is_expandable(record->val.schema, &options)) {
+                return erlang::nif::error(env, "cannot return a column as rows, its type has no value per row, use Adbc.Result.materialize/2 instead");
+            }
+            column_rows += record->val.values->length;
+        }
+        if (n_rows == -1 || column_rows < n_rows) {
+            n_rows = column_rows;
+        }
+    }
+
+    int64_t window_start = offset < n_rows ? offset : (n_rows < 0 ? 0 : n_rows);
+    int64_t window_end = n_rows < 0 ? 0 : n_rows;
+    if (limit != -1 && window_start + limit < window_end) {
+        window_end = window_start + limit;
+    }
+    int64_t window_rows = window_end - window_start;
+    if (window_rows <= 0) {
+        return erlang::nif::ok(env, enif_make_list(env, 0));
+    }
+
+    // the values of row `r` are `cells[r * n_columns, (r + 1) * n_columns)`
+    std::vector<ERL_NIF_TERM> cells((size_t)window_rows * n_columns);
+    for (unsigned int column_i = 0; column_i < n_columns; column_i++) {
+        int64_t record_start = 0;
+        for (auto record : columns[column_i]) {
+            int64_t record_end = record_start + record->val.values->length;
+            int64_t start = record_start > window_start ? record_start : window_start;
+            int64_t end = record_end < window_end ? record_end : window_end;
+            if (start < end) {
+                options.owner = record;
+
+                ERL_NIF_TERM values, values_type;
+                if (adbc_column_materialize_record(env, record, start - record_start, end - start, options, values, values_type, error) != 0) {
+                    return error;
+                }
+                size_t cell_i = (size_t)(start - window_start) * n_columns + column_i;
+                ERL_NIF_TERM value;
+                while (enif_get_list_cell(env, values, &value, &values) && cell_i < cells.size()) {
+                    cells[cell_i] = value;
+                    cell_i += n_columns;
+                }
+                if (cell_i != (size_t)(end - window_start) * n_columns + column_i) {
+                    return erlang::nif::error(env, "invalid ArrowArray, the decoded values do not match its length");
+                }
+            }
+            if (record_end >= window_end) {
+                break;
+            }
+            record_start = record_end;
+        }
+    }
+
+    std::vector<ERL_NIF_TERM> rows(window_rows);
+    for (int64_t row_i = 0; row_i < window_rows; row_i++) {
+        ERL_NIF_TERM * row_values = cells.data() + (size_t)row_i * n_columns;
+        if (as_maps) {
+            if (!enif_make_map_from_arrays(env, keys.data(), row_values, n_columns, &rows[row_i])) {
+                return erlang::nif::error(env, "cannot return rows as maps, two columns have the same key");
+            }
+        } else {
+            rows[row_i] = enif_make_tuple_from_array(env, row_values, n_columns);
+        }
+    }
+    return erlang::nif::ok(env, enif_make_list_from_array(env, rows.data(), (unsigned)rows.size()));
 }
 
 static ERL_NIF_TERM adbc_arrow_array_stream_release(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
@@ -613,6 +1570,18 @@ static ERL_NIF_TERM adbc_arrow_array_stream_release(ErlNifEnv *env, int argc, co
         return error;
     }
 
+    // the prefetch thread must be stopped before the stream is released
+    auto state = (struct ArrowArrayStreamState *)res->private_data;
+    if (state != nullptr && state->prefetch != nullptr) {
+        ArrowArrayStreamPrefetch::destroy(state->prefetch);
+        state->prefetch = nullptr;
+        state->prefetch_depth = 0;
+    }
+    if (state != nullptr && state->pending.release != nullptr) {
+        state->pending.release(&state->pending);
+        state->pending.release = nullptr;
+    }
+
     if (res->val.release) {
         res->val.release(&res->val);
         res->val.release = nullptr;
@@ -671,17 +1640,10 @@ static ERL_NIF_TERM adbc_statement_set_option(ErlNifEnv *env, int argc, const ER
     );
 }
 
-static ERL_NIF_TERM adbc_statement_execute_query(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    using res_type = NifRes<struct AdbcStatement>;
+static ERL_NIF_TERM adbc_statement_execute_query_result(ErlNifEnv *env, NifRes<struct AdbcStatement> * statement) {
     using array_stream_type = NifRes<struct ArrowArrayStream>;
 
     ERL_NIF_TERM error{};
-
-    res_type * statement = nullptr;
-    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
-        return error;
-    }
-
     auto array_stream = array_stream_type::allocate_resource(env, error);
     if (array_stream == nullptr) {
         return error;
@@ -702,7 +1664,7 @@ static ERL_NIF_TERM adbc_statement_execute_query(ErlNifEnv *env, int argc, const
     );
 }
 
-static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+static ERL_NIF_TERM adbc_statement_execute_query(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
 
     ERL_NIF_TERM error{};
@@ -712,6 +1674,25 @@ static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_N
         return error;
     }
 
+    return adbc_statement_execute_query_result(env, statement);
+}
+
+static ERL_NIF_TERM adbc_statement_execute_query_async(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    return adbc_run_async(env, argv[1], {statement}, [statement](ErlNifEnv *msg_env) {
+        return adbc_statement_execute_query_result(msg_env, statement);
+    });
+}
+
+static ERL_NIF_TERM adbc_statement_execute_result(ErlNifEnv *env, NifRes<struct AdbcStatement> * statement) {
     int64_t rows_affected = 0;
     struct AdbcError adbc_error{};
     AdbcStatusCode code = AdbcStatementExecuteQuery(&statement->val, nullptr, &rows_affected, &adbc_error);
@@ -725,6 +1706,34 @@ static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_N
     );
 }
 
+static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    return adbc_statement_execute_result(env, statement);
+}
+
+static ERL_NIF_TERM adbc_statement_execute_async(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    return adbc_run_async(env, argv[1], {statement}, [statement](ErlNifEnv *msg_env) {
+        return adbc_statement_execute_result(msg_env, statement);
+    });
+}
+
 static ERL_NIF_TERM adbc_statement_prepare(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
 
@@ -809,6 +1818,47 @@ cleanup:
     return ret;
 }
 
+static ERL_NIF_TERM adbc_statement_bind_rows(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM ret{};
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    if (!enif_is_list(env, argv[1])) {
+        return enif_make_badarg(env);
+    }
+
+    struct ArrowArray values{};
+    struct ArrowSchema schema{};
+    struct ArrowError arrow_error{};
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code{};
+    values.release = nullptr;
+    schema.release = nullptr;
+
+    if (adbc_rows_to_arrow_type_struct(env, argv[1], &values, &schema, &arrow_error)) {
+        ret = erlang::nif::error(env, arrow_error.message);
+        goto cleanup;
+    }
+
+    code = AdbcStatementBind(&statement->val, &values, &schema, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        ret = nif_error_from_adbc_error(env, &adbc_error);
+        goto cleanup;
+    }
+    ret = erlang::nif::ok(env);
+
+cleanup:
+    if (values.release) values.release(&values);
+    if (schema.release) schema.release(&schema);
+    return ret;
+}
+
 static ERL_NIF_TERM adbc_statement_bind_stream(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
     using array_stream_type = NifRes<struct ArrowArrayStream>;
@@ -833,7 +1883,34 @@ static ERL_NIF_TERM adbc_statement_bind_stream(ErlNifEnv *env, int argc, const E
     return erlang::nif::ok(env);
 }
 
-static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
+/// Starts the executor with the number of threads in `load_info`,
+/// and the materialize executor
+static int adbc_executor_init(ErlNifEnv *env, ERL_NIF_TERM load_info) {
+    if (adbc_executor != nullptr) {
+        adbc_executor_users++;
+        return 0;
+    }
+
+    int n_threads = 0;
+    if (!enif_get_int(env, load_info, &n_threads) || n_threads <= 0) {
+        n_threads = kAdbcExecutorDefaultThreads;
+    }
+    adbc_executor = AdbcExecutor::create((size_t)n_threads);
+    if (adbc_executor == nullptr) {
+        return -1;
+    }
+
+    ErlNifSysInfo info;
+    enif_system_info(&info, sizeof(info));
+    if (info.scheduler_threads > 1) {
+        // materializing works without it, only on the calling thread
+        adbc_materialize_executor = AdbcExecutor::create((size_t)info.scheduler_threads - 1);
+    }
+    adbc_executor_users = 1;
+    return 0;
+}
+
+static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM load_info) {
     ErlNifResourceType *rt;
 
     {
@@ -878,6 +1955,20 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
         res_type::type = rt;
     }
 
+    {
+        using res_type = NifRes<struct AdbcDecoderPlan>;
+        rt = enif_open_resource_type(env, "Elixir.Adbc.Nif", "NifResAdbcDecoderPlan", destruct_adbc_decoder_plan, ERL_NIF_RT_CREATE, NULL);
+        if (!rt) return -1;
+        res_type::type = rt;
+    }
+
+    {
+        using res_type = NifRes<struct AdbcMaterializeState>;
+        rt = enif_open_resource_type(env, "Elixir.Adbc.Nif", "NifResAdbcMaterializeState", destruct_adbc_materialize_state, ERL_NIF_RT_CREATE, NULL);
+        if (!rt) return -1;
+        res_type::type = rt;
+    }
+
     kAtomAdbcError = erlang::nif::atom(env, "adbc_error");
     kAtomNil = erlang::nif::atom(env, "nil");
     kAtomTrue = erlang::nif::atom(env, "true");
@@ -888,6 +1979,7 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAtomNegInfinity = erlang::nif::atom(env, "neg_infinity");
     kAtomNaN = erlang::nif::atom(env, "nan");
     kAtomEndOfSeries = erlang::nif::atom(env, "end_of_series");
+    kAtomPending = erlang::nif::atom(env, "pending");
     kAtomStructKey = erlang::nif::atom(env, "__struct__");
     kAtomValidity = erlang::nif::atom(env, "validity");
     kAtomOffsets = erlang::nif::atom(env, "offsets");
@@ -895,6 +1987,17 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAtomValues = erlang::nif::atom(env, "values");
     kAtomRunEnds = erlang::nif::atom(env, "run_ends");
 
+    kAtomZeroCopy = erlang::nif::atom(env, "zero_copy");
+    kAtomPacked = erlang::nif::atom(env, "packed");
+    kAtomExpandDictionary = erlang::nif::atom(env, "expand_dictionary");
+    kAtomExpand = erlang::nif::atom(env, "expand");
+    kAtomInternStrings = erlang::nif::atom(env, "intern_strings");
+    kAtomMaps = erlang::nif::atom(env, "maps");
+    kAtomDuplicateKeys = erlang::nif::atom(env, "duplicate_keys");
+    kAtomFirst = erlang::nif::atom(env, "first");
+    kAtomLast = erlang::nif::atom(env, "last");
+    kAtomError = erlang::nif::atom(env, "error");
+
     kAtomDecimal = erlang::nif::atom(env, "decimal");
     kAtomFixedSizeBinary = erlang::nif::atom(env, "fixed_size_binary");
     kAtomFixedSizeList = erlang::nif::atom(env, "fixed_size_list");
@@ -926,6 +2029,11 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAtomSecondKey = erlang::nif::atom(env, "second");
     kAtomMicrosecondKey = erlang::nif::atom(env, "microsecond");
 
+    kAtomDecimalModule = erlang::nif::atom(env, "Elixir.Decimal");
+    kAtomSignKey = erlang::nif::atom(env, "sign");
+    kAtomCoefKey = erlang::nif::atom(env, "coef");
+    kAtomExpKey = erlang::nif::atom(env, "exp");
+
     kAtomAdbcColumnModule = erlang::nif::atom(env, "Elixir.Adbc.Column");
     kAtomNameKey = erlang::nif::atom(env, "name");
     kAtomTypeKey = erlang::nif::atom(env, "type");
@@ -951,6 +2059,8 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAdbcColumnTypeLargeBinary = erlang::nif::atom(env, "large_binary");
     kAdbcColumnTypeString = erlang::nif::atom(env, "string");
     kAdbcColumnTypeLargeString = erlang::nif::atom(env, "large_string");
+    kAdbcColumnTypeBinaryView = erlang::nif::atom(env, "binary_view");
+    kAdbcColumnTypeStringView = erlang::nif::atom(env, "string_view");
     kAdbcColumnTypeDate32 = erlang::nif::atom(env, "date32");
     kAdbcColumnTypeDate64 = erlang::nif::atom(env, "date64");
     kAdbcColumnTypeList = erlang::nif::atom(env, "list");
@@ -980,10 +2090,10 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
         {"g", {kAdbcColumnTypeF64}},
         {"z", {kAdbcColumnTypeBinary}},
         {"Z", {kAdbcColumnTypeLargeBinary}},
-        // {"vz", kAdbcColumnTypeBinaryView}, // not implemented yet
+        {"vz", {kAdbcColumnTypeBinaryView}},
         {"u", {kAdbcColumnTypeString}},
         {"U", {kAdbcColumnTypeLargeString}},
-        // {"vu", kAdbcColumnTypeStringView}, // not implemented yet
+        {"vu", {kAdbcColumnTypeStringView}},
         {"tdD", {kAdbcColumnTypeDate32}},
         {"tdm", {kAdbcColumnTypeDate64}},
         // we cannot call enif_make_tuple2 here and reuse the tuple later
@@ -1001,15 +2111,33 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
         {"tin", {kAtomInterval, kAtomMonthDayNano}},
     };
 
-    return 0;
+    return adbc_executor_init(env, load_info);
 }
 
 static int on_reload(ErlNifEnv *, void **, ERL_NIF_TERM) {
     return 0;
 }
 
-static int on_upgrade(ErlNifEnv *, void **, void **, ERL_NIF_TERM) {
-    return 0;
+/// Stops the executors once no instance of the module uses them,
+/// the jobs that have not started reply with an error, and the running
+/// ones finish without being waited for
+static void on_unload(ErlNifEnv *, void *) {
+    if (--adbc_executor_users > 0) {
+        return;
+    }
+    if (adbc_executor != nullptr) {
+        AdbcExecutor::stop_and_release(adbc_executor);
+        adbc_executor = nullptr;
+    }
+    if (adbc_materialize_executor != nullptr) {
+        AdbcExecutor::stop_and_release(adbc_materialize_executor);
+        adbc_materialize_executor = nullptr;
+    }
+    ArrowArrayStreamPrefetch::reap();
+}
+
+static int on_upgrade(ErlNifEnv *env, void **, void **, ERL_NIF_TERM load_info) {
+    return adbc_executor_init(env, load_info);
 }
 
 static ErlNifFunc nif_functions[] = {
@@ -1022,6 +2150,7 @@ static ErlNifFunc nif_functions[] = {
     {"adbc_connection_get_option", 3, adbc_connection_get_option, 0},
     {"adbc_connection_set_option", 4, adbc_connection_set_option, 0},
     {"adbc_connection_init", 2, adbc_connection_init, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_connection_init_async", 3, adbc_connection_init_async, 0},
     {"adbc_connection_get_info", 2, adbc_connection_get_info, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_connection_get_objects", 7, adbc_connection_get_objects, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_connection_get_table_types", 1, adbc_connection_get_table_types, ERL_NIF_DIRTY_JOB_IO_BOUND},
@@ -1031,16 +2160,23 @@ static ErlNifFunc nif_functions[] = {
     {"adbc_statement_set_option", 4, adbc_statement_set_option, 0},
     {"adbc_statement_execute_query", 1, adbc_statement_execute_query, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_execute", 1, adbc_statement_execute, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_statement_execute_query_async", 2, adbc_statement_execute_query_async, 0},
+    {"adbc_statement_execute_async", 2, adbc_statement_execute_async, 0},
     {"adbc_statement_prepare", 1, adbc_statement_prepare, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_set_sql_query", 2, adbc_statement_set_sql_query, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_bind", 2, adbc_statement_bind, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_statement_bind_rows", 2, adbc_statement_bind_rows, ERL_NIF_DIRTY_JOB_CPU_BOUND},
     {"adbc_statement_bind_stream", 2, adbc_statement_bind_stream, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
     {"adbc_arrow_array_stream_get_pointer", 1, adbc_arrow_array_stream_get_pointer, 0},
     {"adbc_arrow_array_stream_next", 1, adbc_arrow_array_stream_next, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_arrow_array_stream_set_rebatch", 3, adbc_arrow_array_stream_set_rebatch, 0},
+    {"adbc_arrow_array_stream_set_prefetch", 2, adbc_arrow_array_stream_set_prefetch, 0},
     {"adbc_arrow_array_stream_release", 1, adbc_arrow_array_stream_release, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
-    {"adbc_column_materialize", 1, adbc_column_materialize, ERL_NIF_DIRTY_JOB_CPU_BOUND},
+    {"adbc_column_materialize", 2, adbc_column_materialize, 0},
+    {"adbc_result_materialize", 2, adbc_result_materialize, ERL_NIF_DIRTY_JOB_CPU_BOUND},
+    {"adbc_result_rows", 5, adbc_result_rows, ERL_NIF_DIRTY_JOB_CPU_BOUND},
 };
 
-ERL_NIF_INIT(Elixir.Adbc.Nif, nif_functions, on_load, on_reload, on_upgrade, NULL);
+ERL_NIF_INIT(Elixir.Adbc.Nif, nif_functions, on_load, on_reload, on_upgrade, on_unload);
@@ -8,6 +8,7 @@
 #include <type_traits>
 #include "nif_utils.hpp"
 #include "adbc_arrow_array_stream_record.hpp"
+#include "adbc_materialize_options.hpp"
 
 // Only for debugging:
 #include <cstdio>
@@ -126,19 +127,42 @@ static void destruct_adbc_error(ErlNifEnv *env, void *args) {
 }
 
 static void destruct_adbc_arrow_array_stream(ErlNifEnv *env, void *args) {
-  auto res = (NifRes<struct AdbcStatement> *)args;
+  auto res = (NifRes<struct ArrowArrayStream> *)args;
   if (res->private_data) {
-    auto schema = (struct ArrowSchema*)res->private_data;
-    if (schema->release) {
-      schema->release(schema);
+    auto state = (struct ArrowArrayStreamState*)res->private_data;
+    if (state->prefetch) {
+      // its thread is asked to stop, it's not joined on this scheduler
+      ArrowArrayStreamPrefetch::abandon(state->prefetch);
+      state->prefetch = nullptr;
+    }
+    if (state->pending.release) {
+      state->pending.release(&state->pending);
+    }
+    if (state->plan_resource) {
+      enif_release_resource(state->plan_resource);
+      state->plan_resource = nullptr;
     }
-    enif_free(schema);
+    enif_free(state);
     res->private_data = nullptr;
   }
 }
 
+static void destruct_adbc_decoder_plan(ErlNifEnv *env, void *args) {
+  auto res = (NifRes<struct AdbcDecoderPlan> *)args;
+  res->val.release();
+}
+
+static void destruct_adbc_materialize_state(ErlNifEnv *env, void *args) {
+  auto res = (NifRes<struct AdbcMaterializeState> *)args;
+  res->val.release();
+}
+
 static void destruct_arrow_array_stream_record(ErlNifEnv *env, void *args) {
   auto res = (NifRes<struct ArrowArrayStreamRecord> *)args;
+  if (res->val.plan_resource) {
+    // borrowed from the decoder plan
+    res->val.schema = nullptr;
+  }
   if (res->val.schema) {
     if (res->val.schema->release) {
       res->val.schema->release(res->val.schema);
@@ -156,6 +180,12 @@ static void destruct_arrow_array_stream_record(ErlNifEnv *env, void *args) {
     enif_free(res->val.values);
     res->val.values = nullptr;
   }
+
+  if (res->val.plan_resource) {
+    enif_release_resource(res->val.plan_resource);
+    res->val.plan_resource = nullptr;
+    res->val.plan_node = nullptr;
+  }
 }
 
 #endif /* ADBC_NIF_RESOURCE_HPP */
@@ -0,0 +1,118 @@
+#ifndef ADBC_STRING_INTERNER_HPP
+#define ADBC_STRING_INTERNER_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <erl_nif.h>
+
+/// @return a 64-bit hash of `nbytes` bytes at `data`, read 8 bytes at a time
+static inline uint64_t adbc_hash_bytes(const uint8_t * data, size_t nbytes) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ (uint64_t)nbytes;
+    size_t i = 0;
+    for (; i + 8 <= nbytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+    }
+    uint64_t tail = 0;
+    if (i < nbytes) {
+        memcpy(&tail, data + i, nbytes - i);
+    }
+    hash = (hash ^ tail) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 29);
+}
+
+/// Returns the same term for the byte strings that repeat while decoding
+/// the records of one materialization, so that a column with few distinct
+/// values holds one binary per distinct value instead of one per row.
+///
+/// The byte strings are not copied, they must outlive the interner, which
+/// they do as it lives in `AdbcMaterializeOptions` for one call, while the
+/// records it decodes are held by the arguments of that call.
+///
+/// Interning gives up for the rest of the call, and every value gets its
+/// own term again, once the values stop repeating: when fewer than half of
+/// the lookups were hits after `kWarmupLookups` of them, or as soon as there
+/// are more than `kMaxDistinct` distinct values.
+struct AdbcStringInterner {
+    static constexpr size_t kMaxDistinct = 4096;
+    static constexpr size_t kWarmupLookups = 1024;
+    // longer values are rarely repeated, they are never interned
+    static constexpr size_t kMaxBytes = 256;
+
+    struct Slot {
+        uint64_t hash;
+        const uint8_t * data;
+        size_t nbytes;
+        // 0 for empty slots
+        ERL_NIF_TERM term;
+    };
+
+    // open addressing with linear probing, at most half full
+    std::vector<Slot> slots;
+    size_t n_distinct = 0;
+    size_t n_lookups = 0;
+    size_t n_hits = 0;
+    bool active = true;
+
+    /// Returns the term of the byte string if it was seen before,
+    /// otherwise makes it with `make()` and remembers it
+    template <typename M> ERL_NIF_TERM intern(const uint8_t * data, size_t nbytes, const M& make) {
+        if (!this->active || nbytes > kMaxBytes) {
+            return make();
+        }
+        if (this->slots.empty()) {
+            this->slots.resize(64, Slot{0, nullptr, 0, 0});
+        }
+
+        uint64_t hash = adbc_hash_bytes(data, nbytes);
+        size_t mask = this->slots.size() - 1;
+        size_t slot_i = (size_t)hash & mask;
+        this->n_lookups++;
+        while (this->slots[slot_i].term != 0) {
+            const Slot &slot = this->slots[slot_i];
+            if (slot.hash == hash && slot.nbytes == nbytes && memcmp(slot.data, data, nbytes) == 0) {
+                this->n_hits++;
+                return slot.term;
+            }
+            slot_i = (slot_i + 1) & mask;
+        }
+
+        ERL_NIF_TERM term = make();
+        this->n_distinct++;
+        if (this->n_distinct > kMaxDistinct || (this->n_lookups >= kWarmupLookups && this->n_hits * 2 < this->n_lookups)) {
+            this->give_up();
+            return term;
+        }
+        this->slots[slot_i] = Slot{hash, data, nbytes, term};
+        if (this->n_distinct * 2 > this->slots.size()) {
+            this->grow();
+        }
+        return term;
+    }
+
+private:
+    void give_up() {
+        this->active = false;
+        std::vector<Slot>().swap(this->slots);
+    }
+
+    void grow() {
+        std::vector<Slot> old_slots(this->slots.size() * 2, Slot{0, nullptr, 0, 0});
+        old_slots.swap(this->slots);
+        size_t mask = this->slots.size() - 1;
+        for (const Slot &slot : old_slots) {
+            if (slot.term == 0) continue;
+            size_t slot_i = (size_t)slot.hash & mask;
+            while (this->slots[slot_i].term != 0) {
+                slot_i = (slot_i + 1) & mask;
+            }
+            this->slots[slot_i] = slot;
+        }
+    }
+};
+
+#endif  // ADBC_STRING_INTERNER_HPP
@@ -16,6 +16,12 @@ defmodule Adbc do
 
       config :adbc, :drivers, [:sqlite]
 
+  Queries are executed on a pool of native threads, so slow queries
+  don't hold up the schedulers of the VM. The pool has 16 threads by
+  default, which can be changed with:
+
+      config :adbc, :executor_threads, 32
+
   If you are using a notebook or scripting, you can also use
   `Adbc.download_driver!/1` to dynamically download one. See
   the function for more information on downloading drivers.
@@ -102,6 +102,8 @@ defmodule Adbc.Column do
           | :large_binary
           | :string
           | :large_string
+          | :binary_view
+          | :string_view
           | decimal
           | {:fixed_size_binary, non_neg_integer()}
           | {:struct, t()}
@@ -776,6 +778,51 @@ defmodule Adbc.Column do
     }
   end
 
+  @doc """
+  A column that contains UTF-8 encoded strings, stored with the view layout.
+
+  Similar to `string/2`, but each value is stored in a 16-byte view. Values of
+  up to 12 bytes are kept inline in the view, and longer values reference one
+  of the data buffers of the array.
+
+  When the column is bound as a parameter or inserted, long binary values are
+  referenced where they are in memory rather than copied, and they are kept
+  alive until the driver releases the array.
+
+  ## Arguments
+
+  * `data`: A list of UTF-8 encoded string values
+  * `opts`: A keyword list of options
+
+  ## Options
+
+  * `:name` - The name of the column
+  * `:nullable` - A boolean value indicating whether the column is nullable
+  * `:metadata` - A map of metadata
+
+  ## Examples
+
+      iex> Adbc.Column.string_view(["a", "ab", "abc"])
+      %Adbc.Column{
+        name: nil,
+        type: :string_view,
+        nullable: false,
+        metadata: nil,
+        data: ["a", "ab", "abc"]
+      }
+
+  """
+  @spec string_view([String.t() | nil], Keyword.t()) :: t()
+  def string_view(data, opts \\ []) when is_list(data) and is_list(opts) do
+    %Adbc.Column{
+      name: opts[:name],
+      type: :string_view,
+      nullable: opts[:nullable] || false,
+      metadata: opts[:metadata] || nil,
+      data: data
+    }
+  end
+
   @doc """
   A column that contains binary values.
 
@@ -852,6 +899,51 @@ defmodule Adbc.Column do
     }
   end
 
+  @doc """
+  A column that contains binary values, stored with the view layout.
+
+  Similar to `binary/2`, but each value is stored in a 16-byte view. Values of
+  up to 12 bytes are kept inline in the view, and longer values reference one
+  of the data buffers of the array.
+
+  When the column is bound as a parameter or inserted, long binary values are
+  referenced where they are in memory rather than copied, and they are kept
+  alive until the driver releases the array.
+
+  ## Arguments
+
+  * `data`: A list of binary values
+  * `opts`: A keyword list of options
+
+  ## Options
+
+  * `:name` - The name of the column
+  * `:nullable` - A boolean value indicating whether the column is nullable
+  * `:metadata` - A map of metadata
+
+  ## Examples
+
+      iex> Adbc.Column.binary_view([<<0>>, <<1>>, <<2>>])
+      %Adbc.Column{
+        name: nil,
+        type: :binary_view,
+        nullable: false,
+        metadata: nil,
+        data: [<<0>>, <<1>>, <<2>>]
+      }
+
+  """
+  @spec binary_view([iodata() | nil], Keyword.t()) :: t()
+  def binary_view(data, opts \\ []) when is_list(data) and is_list(opts) do
+    %Adbc.Column{
+      name: opts[:name],
+      type: :binary_view,
+      nullable: opts[:nullable] || false,
+      metadata: opts[:metadata] || nil,
+      data: data
+    }
+  end
+
   @doc """
   A column that contains fixed size binaries.
 
@@ -1370,67 +1462,221 @@ defmodule Adbc.Column do
   end
 
   @doc """
-  `materialize/1` converts a column's data from reference type to regular Elixir terms.
+  A column of a fixed-width type whose values are already packed in a binary.
+
+  This is the layout `materialize/2` returns with `packed: true`, so such
+  columns can be bound as parameters as they are. When the column is bound,
+  the binary becomes the Arrow data buffer as is, without parsing or copying
+  the values, and it is kept alive until the driver releases the array.
+
+  ## Arguments
+
+  * `type`: One of `:s8`, `:s16`, `:s32`, `:s64`, `:u8`, `:u16`, `:u32`,
+    `:u64`, `:f16`, `:f32`, `:f64`, `:date32`, `:date64`, `{:time32, unit}`,
+    `{:time64, unit}`, `{:timestamp, unit, timezone}` or `{:duration, unit}`
+  * `values`: A binary with the values in little-endian order. Temporal values
+    are integers in the unit of the type.
+  * `opts`: A keyword list of options
+
+  ## Options
+
+  * `:validity` - An Arrow validity bitmap (least significant bit first), with
+    the bit of each non-null value set, or `nil` when there are no nulls.
+    Defaults to `nil`.
+  * `:name` - The name of the column
+  * `:nullable` - A boolean value indicating whether the column is nullable.
+    Defaults to `true` when `:validity` is given, `false` otherwise.
+  * `:metadata` - A map of metadata
+
+  ## Examples
+
+      iex> Adbc.Column.packed(:s16, <<1::little-16, 2::little-16, 3::little-16>>)
+      %Adbc.Column{
+        name: nil,
+        type: :s16,
+        nullable: false,
+        metadata: nil,
+        data: %{values: <<1, 0, 2, 0, 3, 0>>, validity: nil},
+        length: 3
+      }
+
+  """
+  @spec packed(data_type(), binary(), Keyword.t()) :: t()
+  def packed(type, values, opts \\ []) when is_binary(values) and is_list(opts) do
+    size =
+      case packed_type(type) do
+        {_, bits} -> div(bits, 8)
+        nil -> raise Adbc.Error, "packed values are not supported for type #{inspect(type)}"
+      end
+
+    if rem(byte_size(values), size) != 0 do
+      raise Adbc.Error,
+            "expected packed #{inspect(type)} values to take a multiple of #{size} bytes, " <>
+              "got: #{byte_size(values)} bytes"
+    end
+
+    length = div(byte_size(values), size)
+    validity = opts[:validity]
+
+    unless is_nil(validity) or (is_binary(validity) and byte_size(validity) * 8 >= length) do
+      raise Adbc.Error,
+            "expected :validity to be nil or a bitmap of at least #{length} bits, " <>
+              "got: #{inspect(validity)}"
+    end
+
+    %Adbc.Column{
+      name: opts[:name],
+      type: type,
+      nullable: Keyword.get(opts, :nullable, validity != nil),
+      metadata: opts[:metadata] || nil,
+      data: %{values: values, validity: validity},
+      length: length
+    }
+  end
+
+  # options of materialize/2, also accepted by Adbc.Result
+  @materialize_opts [
+    zero_copy: false,
+    packed: false,
+    expand_dictionary: false,
+    expand: false,
+    intern_strings: false,
+    maps: false,
+    duplicate_keys: :last
+  ]
+
+  @doc """
+  `materialize/2` converts a column's data from reference type to regular Elixir terms.
+
+  Columns of primitive, string and binary values are decoded in slices on
+  a regular scheduler, yielding between slices, so materializing them does
+  not hold up other processes. Nested and dictionary-encoded chunks are
+  decoded on a dirty CPU scheduler.
+
+  Decimal values, including the ones nested in lists and structs, are
+  built as `Decimal` structs directly while decoding.
+
+  ## Arguments
+
+  * `column` - The column to materialize
+  * `opts` - A keyword list of options
+
+  ## Options
+
+  * `:zero_copy` - When `true`, string and binary values (including fixed-size
+    binaries) are returned as sub-binaries that reference the Arrow buffers
+    instead of being copied. For string and binary views, only the values
+    longer than 12 bytes reference the buffers, shorter ones are stored inline
+    in the view and are always copied. Defaults to `false`.
+
+    Every such binary keeps the whole record batch it came from alive, so
+    holding on to a few small values can retain a lot of memory. Use
+    `:binary.copy/1` on the values that need to outlive the batch.
+
+  * `:packed` - When `true`, integer, floating point, date, time, timestamp
+    and duration columns are returned as `%{values: binary, validity: bitmap}`
+    instead of a list, and `:length` is set to the number of rows. `values`
+    holds the raw values in little-endian order, ready to be given to Nx or
+    Explorer, and `validity` is an Arrow validity bitmap (least significant
+    bit first) or `nil` when there are no nulls. Temporal values are kept as
+    integers in the unit of the column type. Other column types are
+    materialized as usual. Defaults to `false`.
+
+    When the column has a single chunk, the binaries reference the Arrow
+    buffers instead of copying them.
+
+  * `:expand_dictionary` - When `true`, dictionary-encoded columns are
+    returned as a list with the value of each row, and take the type of the
+    dictionary values, as `to_list/1` would return them. Each value of the
+    dictionary is decoded once and shared by all rows that reference it, so
+    a low-cardinality string column holds one binary per distinct value.
+    Dictionaries of nested types are not expanded. Defaults to `false`.
+
+  * `:expand` - When `true`, list view and run-end encoded columns are
+    returned as a list with the value of each row, as `to_list/1` would
+    return them, and dictionaries are expanded as with `:expand_dictionary`.
+    The rows are sliced out of the Arrow buffers natively, without building
+    the offsets, sizes or run ends as Elixir lists first. The column keeps
+    its type. Encoded columns whose values are nested types other than
+    these are not expanded. Defaults to `false`.
+
+  * `:intern_strings` - When `true`, string and binary values that repeat
+    share one binary, so low-cardinality text columns that are not
+    dictionary-encoded take a fraction of the memory. Values are shared across
+    all the chunks decoded in one step, large columns take a few steps.
+    Interning gives up once the values stop repeating, so it costs little on
+    high-cardinality columns. Defaults to `false`.
+
+  * `:maps` - When `true`, map columns are returned as a list with an Elixir
+    map for each row, or `nil` for null rows, instead of their key and value
+    columns. The maps are built natively from the entries of each row. The
+    column keeps its type. Maps whose keys or values are nested types that
+    cannot be expanded are not converted. Defaults to `false`.
+
+  * `:duplicate_keys` - What to do with a key that appears more than once
+    in a row when `:maps` is `true`: `:last` keeps the value of its last
+    entry, `:first` keeps the value of its first entry, and `:error` fails
+    the materialization. Defaults to `:last`.
   """
-  @spec materialize(t()) ::
+  @spec materialize(t(), Keyword.t()) ::
           t() | {:error, String.t()}
-  def materialize(%Adbc.Column{data: data_ref} = self)
-      when is_reference(data_ref) or is_list(data_ref) do
-    if is_list(data_ref) do
-      if Enum.all?(data_ref, &is_reference/1) do
-        do_materialize(self)
-      else
-        self
-      end
+  def materialize(column, opts \\ [])
+
+  def materialize(%Adbc.Column{} = self, opts) do
+    opts = Keyword.validate!(opts, @materialize_opts)
+
+    if materializable?(self) do
+      do_materialize(self, opts)
     else
-      do_materialize(self)
+      self
     end
   end
 
-  def materialize(%Adbc.Column{} = self) do
-    self
-  end
+  @doc false
+  def materialize_opts, do: @materialize_opts
 
-  defp do_materialize(%Adbc.Column{data: data_ref, type: type} = self) do
-    with {:ok, results} <- Adbc.Nif.adbc_column_materialize(data_ref) do
-      materialized =
-        Enum.reduce(results, [], fn result, acc ->
-          acc ++ result
-        end)
+  @doc false
+  def materializable?(%Adbc.Column{data: data_ref}) when is_reference(data_ref), do: true
 
-      type =
-        case type do
-          {:list, _} ->
-            :list
+  def materializable?(%Adbc.Column{data: data_ref}) when is_list(data_ref),
+    do: Enum.all?(data_ref, &is_reference/1)
 
-          _ ->
-            type
-        end
+  def materializable?(%Adbc.Column{}), do: false
 
-      handle_decimal(%{self | data: materialized, type: type})
+  defp do_materialize(%Adbc.Column{data: data_ref} = self, opts) do
+    case Adbc.Nif.adbc_column_materialize(data_ref, Map.new(opts)) do
+      {:ok, materialized} ->
+        from_materialized(self, materialized)
+
+      error ->
+        error
     end
   end
 
-  defp handle_decimal(%Adbc.Column{type: {:decimal, bits, _, scale}, data: decimal_data} = column) do
-    %{column | data: handle_decimal(decimal_data, bits, scale)}
+  @doc false
+  def from_materialized(self, {:dictionary, type, values}) do
+    do_materialize_list(self, type, values)
   end
 
-  defp handle_decimal(column) do
-    column
+  def from_materialized(self, {values, validity, length}) do
+    %{self | data: %{values: values, validity: validity}, length: length}
   end
 
-  defp handle_decimal(decimal_data, bits, scale) do
-    Enum.map(decimal_data, fn
-      <<decimal::signed-integer-size(bits)-little>> ->
-        if decimal < 0 do
-          Decimal.new(-1, -decimal, -scale)
-        else
-          Decimal.new(1, decimal, -scale)
-        end
+  def from_materialized(%Adbc.Column{type: type} = self, materialized) do
+    do_materialize_list(self, type, materialized)
+  end
 
-      nil ->
-        nil
-    end)
+  defp do_materialize_list(self, type, materialized) do
+    type =
+      case type do
+        {:list, _} ->
+          :list
+
+        _ ->
+          type
+      end
+
+    %{self | data: materialized, type: type}
   end
 
   @doc """
@@ -1585,8 +1831,73 @@ defmodule Adbc.Column do
     struct_to_list(data)
   end
 
+  def to_list(%Adbc.Column{
+        type: type,
+        data: %{values: values, validity: validity},
+        length: length
+      })
+      when is_binary(values) and is_integer(length) do
+    values =
+      case packed_type(type) do
+        {:s, size} -> for <<value::signed-integer-little-size(size) <- values>>, do: value
+        {:u, size} -> for <<value::unsigned-integer-little-size(size) <- values>>, do: value
+        {:f, size} -> for <<value::bitstring-size(size) <- values>>, do: packed_float(value, size)
+      end
+
+    if validity do
+      bits = for <<byte <- validity>>, bit <- 0..7, do: byte >>> bit &&& 1
+
+      Enum.zip_with(values, bits, fn
+        value, 1 -> value
+        _value, 0 -> nil
+      end)
+    else
+      values
+    end
+  end
+
   def to_list(%Adbc.Column{data: data}), do: data
 
+  defp packed_type(:s8), do: {:s, 8}
+  defp packed_type(:s16), do: {:s, 16}
+  defp packed_type(:s32), do: {:s, 32}
+  defp packed_type(:s64), do: {:s, 64}
+  defp packed_type(:u8), do: {:u, 8}
+  defp packed_type(:u16), do: {:u, 16}
+  defp packed_type(:u32), do: {:u, 32}
+  defp packed_type(:u64), do: {:u, 64}
+  defp packed_type(:f16), do: {:f, 16}
+  defp packed_type(:f32), do: {:f, 32}
+  defp packed_type(:f64), do: {:f, 64}
+  defp packed_type(:date32), do: {:s, 32}
+  defp packed_type(:date64), do: {:s, 64}
+  defp packed_type({:time32, _}), do: {:s, 32}
+  defp packed_type({:time64, _}), do: {:s, 64}
+  defp packed_type({:timestamp, _, _}), do: {:s, 64}
+  defp packed_type({:duration, _}), do: {:s, 64}
+  defp packed_type(_), do: nil
+
+  defp packed_float(bits, size) do
+    case bits do
+      <<value::float-little-size(size)>> ->
+        value
+
+      <<value::unsigned-integer-little-size(size)>> ->
+        mantissa_bits =
+          case size do
+            16 -> 10
+            32 -> 23
+            64 -> 52
+          end
+
+        cond do
+          (value &&& (1 <<< mantissa_bits) - 1) != 0 -> :nan
+          value >>> (size - 1) == 1 -> :neg_infinity
+          true -> :infinity
+        end
+    end
+  end
+
   defp struct_to_list(data) do
     %Adbc.Result{data: data, num_rows: nil}
     |> Table.to_rows()
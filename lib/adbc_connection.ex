@@ -11,6 +11,7 @@ defmodule Adbc.Connection do
 
   use GenServer
   import Adbc.Helper, only: [error_to_exception: 1]
+  require Logger
 
   @doc """
   Starts a connection process.
@@ -22,6 +23,22 @@ defmodule Adbc.Connection do
     * `:process_options` - the options to be given to the underlying
       process. See `GenServer.start_link/3` for all options
 
+    * `:rebatch` - how many driver batches are read per call into the
+      driver. Given a keyword list, batches are read natively until either
+      `:target_rows` rows or roughly `:target_bytes` bytes have been read,
+      so the number of round trips from Elixir does not depend on the batch
+      size of the driver. `:target_rows` defaults to `65536`, `:target_bytes`
+      defaults to `16_777_216`, and a limit of `0` disables it.
+      The batches are not merged: each one is still a chunk of its own in
+      `Adbc.Column.data`. They are not split either: a batch that would
+      exceed a limit is read by the next call instead, and a single batch
+      larger than the limits is read on its own. Defaults to `false`, which
+      reads one driver batch per call
+
+    * `:prefetch` - the number of driver batches to read ahead on a native
+      thread while the current ones are being converted, or `0` to read
+      them only when they are requested. Defaults to `0`
+
   ## Examples
 
       Adbc.Connection.start_link(
@@ -46,10 +63,17 @@ defmodule Adbc.Connection do
     end
 
     {process_options, opts} = Keyword.pop(opts, :process_options, [])
+    {rebatch, opts} = Keyword.pop(opts, :rebatch, false)
+    rebatch = normalize_rebatch(rebatch)
+    {prefetch, opts} = Keyword.pop(opts, :prefetch, 0)
+
+    unless is_integer(prefetch) and prefetch >= 0 do
+      raise ArgumentError, ":prefetch must be a non-negative integer, got: #{inspect(prefetch)}"
+    end
 
     with {:ok, conn} <- Adbc.Nif.adbc_connection_new(),
          :ok <- init_options(conn, opts) do
-      GenServer.start_link(__MODULE__, {db, conn}, process_options)
+      GenServer.start_link(__MODULE__, {db, conn, rebatch, prefetch}, process_options)
     else
       {:error, reason} -> {:error, error_to_exception(reason)}
     end
@@ -119,6 +143,27 @@ defmodule Adbc.Connection do
     Adbc.Helper.option(conn, :adbc_connection_set_option, [:float, key, value])
   end
 
+  defp normalize_rebatch(false), do: {0, 0}
+
+  defp normalize_rebatch(opts) when is_list(opts) do
+    opts = Keyword.validate!(opts, target_rows: 65536, target_bytes: 16_777_216)
+    target_rows = Keyword.fetch!(opts, :target_rows)
+    target_bytes = Keyword.fetch!(opts, :target_bytes)
+
+    unless is_integer(target_rows) and target_rows >= 0 and
+             is_integer(target_bytes) and target_bytes >= 0 do
+      raise ArgumentError,
+            ":rebatch expects non-negative integers for :target_rows and :target_bytes, " <>
+              "got: #{inspect(opts)}"
+    end
+
+    {target_rows, target_bytes}
+  end
+
+  defp normalize_rebatch(other) do
+    raise ArgumentError, ":rebatch must be a keyword list or false, got: #{inspect(other)}"
+  end
+
   defp init_options(ref, opts) do
     Enum.reduce_while(opts, :ok, fn
       {key, value}, :ok when is_atom(value) or is_binary(value) ->
@@ -175,6 +220,64 @@ defmodule Adbc.Connection do
     end
   end
 
+  @doc """
+  Runs the given `query` once for each row of parameters in `rows`.
+
+  The rows are bound to the statement as a single batch, with one column
+  per parameter, and the driver runs the statement for each of them. This
+  is much faster than calling `query/4` for each row when inserting or
+  updating many rows.
+
+  The type of each parameter is inferred from its first value that is not
+  `nil`: integers are bound as 64-bit integers, floats as doubles, binaries
+  as strings, booleans as booleans, `Date`s as 32-bit dates, `Time`s and
+  `NaiveDateTime`s as times and timestamps in microseconds, and `Decimal`s
+  as 128-bit decimals with a precision of 38 and the largest scale of the
+  parameter. An `Adbc.Column` with a single value binds that value with
+  the type of the column. All rows must have the same number of parameters,
+  and a parameter must have the same type in all rows, except that integers
+  are accepted where floats were inferred.
+
+  ## Arguments
+
+    * `conn` - The connection process
+    * `query` - The query, or a statement returned by `prepare/2`
+    * `rows` - A list of parameter rows, each a tuple or a list
+    * `statement_options` - Options set on the statement
+
+  ## Examples
+
+      Adbc.Connection.execute_many(
+        conn,
+        "INSERT INTO users (id, name) VALUES (?, ?)",
+        [{1, "Alice"}, {2, "Bob"}, {3, nil}]
+      )
+      #=> {:ok, 3}
+
+  """
+  @spec execute_many(t(), binary | reference, [tuple | list], Keyword.t()) ::
+          {:ok, non_neg_integer() | nil} | {:error, Exception.t()}
+  def execute_many(conn, query, rows, statement_options \\ [])
+      when (is_binary(query) or is_reference(query)) and is_list(rows) and
+             is_list(statement_options) do
+    case rows do
+      [] -> {:ok, 0}
+      _ -> command(conn, {:execute_many, query, rows, statement_options})
+    end
+  end
+
+  @doc """
+  Same as `execute_many/4` but raises an exception on error.
+  """
+  @spec execute_many!(t(), binary | reference, [tuple | list], Keyword.t()) ::
+          non_neg_integer() | nil
+  def execute_many!(conn, query, rows, statement_options \\ []) do
+    case execute_many(conn, query, rows, statement_options) do
+      {:ok, rows_affected} -> rows_affected
+      {:error, reason} -> raise reason
+    end
+  end
+
   @doc """
   Prepares the given `query`.
   """
@@ -572,12 +675,13 @@ defmodule Adbc.Connection do
   defp normalize_rows(-1), do: nil
   defp normalize_rows(rows) when is_integer(rows) and rows >= 0, do: rows
 
-  defp stream_results(_conn, reference, num_rows), do: do_stream_results(reference, [], num_rows)
+  defp stream_results(conn, reference, num_rows),
+    do: do_stream_results(conn, reference, [], num_rows)
 
-  defp do_stream_results(reference, acc, num_rows) do
-    case Adbc.Nif.adbc_arrow_array_stream_next(reference) do
+  defp do_stream_results(conn, reference, acc, num_rows) do
+    case stream_next(conn, reference) do
       {:ok, result} ->
-        do_stream_results(reference, [result | acc], num_rows)
+        do_stream_results(conn, reference, [result | acc], num_rows)
 
       :end_of_series ->
         {:ok, %Adbc.Result{data: merge_columns(Enum.reverse(acc)), num_rows: num_rows}}
@@ -587,22 +691,58 @@ defmodule Adbc.Connection do
     end
   end
 
-  defp merge_columns(chucked_results) do
-    Enum.zip_with(chucked_results, fn columns ->
-      Enum.reduce(columns, fn column, merged_column ->
-        %{merged_column | data: merged_column.data ++ column.data}
-      end)
+  # how long to wait for a prefetched batch before asking for it again
+  @prefetch_poll_interval 5_000
+
+  defp stream_next(conn, reference) do
+    case Adbc.Nif.adbc_arrow_array_stream_next(reference) do
+      # the batch is still being prefetched, we are notified once it is ready,
+      # unless the connection exits first
+      {:pending, tag} ->
+        monitor = Process.monitor(conn)
+
+        receive do
+          {:adbc_stream_ready, ^tag} ->
+            Process.demonitor(monitor, [:flush])
+            stream_next(conn, reference)
+
+          {:DOWN, ^monitor, _, _, reason} ->
+            {:error, "connection exited while reading the stream: #{inspect(reason)}"}
+        after
+          @prefetch_poll_interval ->
+            Process.demonitor(monitor, [:flush])
+            result = stream_next(conn, reference)
+
+            # the batch may have been ready just before asking again
+            receive do
+              {:adbc_stream_ready, ^tag} -> :ok
+            after
+              0 -> :ok
+            end
+
+            result
+        end
+
+      result ->
+        result
+    end
+  end
+
+  defp merge_columns(chunked_results) do
+    Enum.zip_with(chunked_results, fn [column | _] = columns ->
+      %{column | data: Enum.flat_map(columns, & &1.data)}
     end)
   end
 
   ## Callbacks
 
   @impl true
-  def init({db, conn}) do
+  def init({db, conn, rebatch, prefetch}) do
     case GenServer.call(db, {:initialize_connection, conn}, :infinity) do
       {:ok, driver} ->
         Process.put(:adbc_driver, driver)
-        {:ok, %{conn: conn, lock: :none, queue: :queue.new()}}
+        {:ok,
+         %{conn: conn, lock: :none, queue: :queue.new(), rebatch: rebatch, prefetch: prefetch}}
 
       {:error, reason} ->
         {:stop, error_to_exception(reason)}
@@ -640,6 +780,14 @@ defmodule Adbc.Connection do
     {:noreply, maybe_dequeue(%{state | lock: :none})}
   end
 
+  def handle_info(msg, state) do
+    Logger.warning(
+      "#{inspect(__MODULE__)} #{inspect(self())} received unexpected message: #{inspect(msg)}"
+    )
+
+    {:noreply, state}
+  end
+
   ## Queue helpers
 
   defp maybe_dequeue(%{lock: :none, queue: queue} = state) do
@@ -657,6 +805,13 @@ defmodule Adbc.Connection do
 
         case handle_stream(command, state.conn) do
           {:ok, stream_ref, rows_affected} when is_reference(stream_ref) ->
+            {target_rows, target_bytes} = state.rebatch
+            Adbc.Nif.adbc_arrow_array_stream_set_rebatch(stream_ref, target_rows, target_bytes)
+
+            if state.prefetch > 0 do
+              Adbc.Nif.adbc_arrow_array_stream_set_prefetch(stream_ref, state.prefetch)
+            end
+
             unlock_ref = Process.monitor(pid)
             GenServer.reply(from, {:ok, self(), unlock_ref, stream_ref, rows_affected})
             %{state | lock: {unlock_ref, stream_ref}, queue: queue}
@@ -681,7 +836,7 @@ defmodule Adbc.Connection do
     with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(conn),
          :ok <- init_statement_options(stmt, options),
          :ok <- Adbc.Nif.adbc_statement_bind_stream(stmt, stream_ref),
-         {:ok, rows_affected} <- Adbc.Nif.adbc_statement_execute(stmt) do
+         {:ok, rows_affected} <- execute(stmt) do
       {:ok, rows_affected}
     end
   end
@@ -690,18 +845,30 @@ defmodule Adbc.Connection do
     with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(conn),
          :ok <- init_statement_options(stmt, options),
          :ok <- Adbc.Nif.adbc_statement_bind(stmt, columns),
-         {:ok, rows_affected} <- Adbc.Nif.adbc_statement_execute(stmt) do
+         {:ok, rows_affected} <- execute(stmt) do
       {:ok, rows_affected}
     end
   end
 
+  defp handle_command({:execute_many, query_or_prepared, rows, statement_options}, conn) do
+    with {:ok, stmt} <- ensure_statement(conn, query_or_prepared, statement_options),
+         :ok <- Adbc.Nif.adbc_statement_bind_rows(stmt, rows),
+         {:ok, rows_affected} <- execute(stmt) do
+      {:ok, normalize_rows(rows_affected)}
+    end
+  end
+
   defp handle_stream({:query, query_or_prepared, params, statement_options}, conn) do
     with {:ok, stmt} <- ensure_statement(conn, query_or_prepared, statement_options),
          :ok <- maybe_bind(stmt, params) do
-      Adbc.Nif.adbc_statement_execute_query(stmt)
+      Adbc.Helper.await_async(&Adbc.Nif.adbc_statement_execute_query_async(stmt, &1))
     end
   end
 
+  defp execute(stmt) do
+    Adbc.Helper.await_async(&Adbc.Nif.adbc_statement_execute_async(stmt, &1))
+  end
+
   defp handle_stream({name, args}, conn) do
     with {:ok, stream_ref} <- apply(Adbc.Nif, name, [conn | args]) do
       {:ok, stream_ref, -1}
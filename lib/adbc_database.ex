@@ -137,7 +137,7 @@ defmodule Adbc.Database do
 
   @impl true
   def handle_call({:initialize_connection, conn_ref}, {pid, _}, {driver, db}) do
-    case Adbc.Nif.adbc_connection_init(conn_ref, db) do
+    case Adbc.Helper.await_async(&Adbc.Nif.adbc_connection_init_async(conn_ref, db, &1)) do
       :ok ->
         Process.link(pid)
         {:reply, {:ok, driver}, {driver, db}}
@@ -46,6 +46,28 @@ defmodule Adbc.Helper do
     end
   end
 
+  # Runs an async NIF, which is given a reference and replies with
+  # `{ref, result}` once the call completes on the native executor.
+  #
+  # The executor always replies, with an error if it's stopped before the
+  # call could start. There is no timeout: the handle the call uses must
+  # not be used again before the call is done, ADBC handles are not
+  # thread-safe, so the caller has to wait for the reply.
+  @doc false
+  def await_async(fun) do
+    ref = make_ref()
+
+    case fun.(ref) do
+      :ok ->
+        receive do
+          {^ref, result} -> result
+        end
+
+      {:error, _} = error ->
+        error
+    end
+  end
+
   @doc false
   def download(url, ignore_proxy) do
     url_charlist = String.to_charlist(url)
@@ -6,7 +6,9 @@ defmodule Adbc.Nif do
     :ok = Adbc.DLLLoaderNif.init()
     nif_file = ~c"#{:code.priv_dir(:adbc)}/adbc_nif"
 
-    case :erlang.load_nif(nif_file, 0) do
+    executor_threads = Application.get_env(:adbc, :executor_threads, 16)
+
+    case :erlang.load_nif(nif_file, executor_threads) do
       :ok -> :ok
       {:error, {:reload, _}} -> :ok
       {:error, reason} -> IO.puts("Failed to load nif: #{inspect(reason)}")
@@ -29,6 +31,8 @@ defmodule Adbc.Nif do
 
   def adbc_connection_init(_self, _database), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_connection_init_async(_self, _database, _ref), do: :erlang.nif_error(:not_loaded)
+
   def adbc_connection_get_info(_self, _info_codes), do: :erlang.nif_error(:not_loaded)
 
   def adbc_connection_get_objects(
@@ -54,19 +58,36 @@ defmodule Adbc.Nif do
 
   def adbc_statement_execute(_self), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_statement_execute_query_async(_self, _ref), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_statement_execute_async(_self, _ref), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_prepare(_self), do: :erlang.nif_error(:not_loaded)
 
   def adbc_statement_set_sql_query(_self, _query), do: :erlang.nif_error(:not_loaded)
 
   def adbc_statement_bind(_self, _values), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_statement_bind_rows(_self, _rows), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_bind_stream(_self, _stream), do: :erlang.nif_error(:not_loaded)
 
   def adbc_arrow_array_stream_get_pointer(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
 
   def adbc_arrow_array_stream_next(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_arrow_array_stream_set_rebatch(_arrow_array_stream, _target_rows, _target_bytes),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_set_prefetch(_arrow_array_stream, _depth),
+    do: :erlang.nif_error(:not_loaded)
+
   def adbc_arrow_array_stream_release(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
 
-  def adbc_column_materialize(_data_ref), do: :erlang.nif_error(:not_loaded)
+  def adbc_column_materialize(_data_ref, _opts), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_result_materialize(_data_refs, _opts), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_result_rows(_data_refs, _keys, _offset, _limit, _opts),
+    do: :erlang.nif_error(:not_loaded)
 end
@@ -45,12 +45,131 @@ defmodule Adbc.Result do
         }
 
   @doc """
-  `materialize/1` converts the result set's data from reference type to regular Elixir terms.
+  `materialize/2` converts the result set's data from reference type to regular Elixir terms.
+
+  `opts` are the same as in `Adbc.Column.materialize/2` and apply to every column.
+
+  All columns are materialized in a single call, which decodes the columns
+  in parallel on a pool of native threads. If any column fails, the error
+  is returned as `{:error, reason}`.
   """
-  @spec materialize(%Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()}) ::
+  @spec materialize(
+          %Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()},
+          Keyword.t()
+        ) ::
           %Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()}
-  def materialize(%Adbc.Result{data: data} = result) when is_list(data) do
-    %{result | data: Enum.map(data, &Adbc.Column.materialize/1)}
+  def materialize(result, opts \\ [])
+
+  def materialize(%Adbc.Result{data: data} = result, opts) when is_list(data) do
+    opts = Keyword.validate!(opts, Adbc.Column.materialize_opts())
+
+    columns = Enum.filter(data, &Adbc.Column.materializable?/1)
+
+    with [_ | _] <- columns,
+         {:ok, materialized} <-
+           Adbc.Nif.adbc_result_materialize(Enum.map(columns, & &1.data), Map.new(opts)) do
+      {data, []} =
+        Enum.map_reduce(data, materialized, fn column, materialized ->
+          if Adbc.Column.materializable?(column) do
+            [values | materialized] = materialized
+            {Adbc.Column.from_materialized(column, values), materialized}
+          else
+            {column, materialized}
+          end
+        end)
+
+      %{result | data: data}
+    else
+      {:error, _} = error ->
+        error
+
+      # nothing to materialize
+      [] ->
+        result
+    end
+  end
+
+  @doc """
+  `to_rows/2` returns the rows of the result set, as tuples or maps.
+
+  The rows are built natively from the Arrow data, column by column,
+  without materializing each column into a list first, and only the
+  rows between `:offset` and `:offset` + `:limit` are decoded.
+
+  Columns whose type has no value per row, such as lists and structs,
+  cannot be returned as rows, use `materialize/2` for those. Columns that
+  are already materialized are zipped in Elixir instead.
+
+  ## Arguments
+
+  * `result` - The result to return the rows of
+  * `opts` - A keyword list of options
+
+  ## Options
+
+  * `:as` - `:tuple` for a tuple with the value of each column, in order,
+    or `:map` for a map from the name of each column to its value.
+    Defaults to `:tuple`.
+
+  * `:offset` - The number of rows to skip. Defaults to `0`.
+
+  * `:limit` - The maximum number of rows to return, or `nil` for all of
+    them. Defaults to `nil`.
+
+  `:zero_copy`, `:expand_dictionary`, `:expand`, `:intern_strings`, `:maps` and
+  `:duplicate_keys` are the same as in `Adbc.Column.materialize/2`.
+  """
+  @spec to_rows(%Adbc.Result{}, Keyword.t()) :: [tuple()] | [map()] | {:error, String.t()}
+  def to_rows(%Adbc.Result{data: data}, opts \\ []) when is_list(data) do
+    opts =
+      Keyword.validate!(
+        opts,
+        [as: :tuple, offset: 0, limit: nil] ++
+          Keyword.delete(Adbc.Column.materialize_opts(), :packed)
+      )
+
+    {as, opts} = Keyword.pop!(opts, :as)
+    {offset, opts} = Keyword.pop!(opts, :offset)
+    {limit, opts} = Keyword.pop!(opts, :limit)
+
+    unless as in [:tuple, :map] do
+      raise ArgumentError, "expected :as to be :tuple or :map, got: #{inspect(as)}"
+    end
+
+    unless is_integer(offset) and offset >= 0 do
+      raise ArgumentError,
+            "expected :offset to be a non-negative integer, got: #{inspect(offset)}"
+    end
+
+    unless is_nil(limit) or (is_integer(limit) and limit >= 0) do
+      raise ArgumentError,
+            "expected :limit to be nil or a non-negative integer, got: #{inspect(limit)}"
+    end
+
+    keys = if as == :map, do: Enum.map(data, & &1.name)
+
+    if Enum.all?(data, &Adbc.Column.materializable?/1) do
+      case Adbc.Nif.adbc_result_rows(
+             Enum.map(data, & &1.data),
+             keys,
+             offset,
+             limit || -1,
+             Map.new(opts)
+           ) do
+        {:ok, rows} -> rows
+        error -> error
+      end
+    else
+      rows =
+        data
+        |> Enum.map(&(&1 |> Adbc.Column.materialize(opts) |> Adbc.Column.to_list()))
+        |> Enum.zip_with(fn values ->
+          if keys, do: Map.new(Enum.zip(keys, values)), else: List.to_tuple(values)
+        end)
+        |> Enum.drop(offset)
+
+      if limit, do: Enum.take(rows, limit), else: rows
+    end
   end
 
   @doc """
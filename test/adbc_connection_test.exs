@@ -30,6 +30,12 @@ defmodule Adbc.ConnectionTest do
       assert_receive {:DOWN, ^ref, _, _, _}
     end
 
+    test "validates the rebatch option", %{db: db} do
+      assert_raise ArgumentError, ~r/:rebatch must be a keyword list or false/, fn ->
+        Connection.start_link(database: db, rebatch: 1024)
+      end
+    end
+
     test "errors with invalid option", %{db: db} do
       Process.flag(:trap_exit, true)
 
@@ -400,6 +406,179 @@ defmodule Adbc.ConnectionTest do
                ]
              } = Adbc.Result.materialize(results)
     end
+
+    test "select with zero_copy", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      query = "SELECT 'hello' as text, x'0102' as blob UNION ALL SELECT 'world', x'03'"
+      {:ok, results} = Connection.query(conn, query)
+
+      assert %Adbc.Result{
+               data: [
+                 %Adbc.Column{name: "text", data: ["hello", "world"]},
+                 %Adbc.Column{name: "blob", data: [<<1, 2>>, <<3>>]}
+               ]
+             } = materialized = Adbc.Result.materialize(results, zero_copy: true)
+
+      assert materialized == Adbc.Result.materialize(results)
+    end
+
+    test "select with packed", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      query =
+        "SELECT 1 as num, 1.5 as float, 'a' as text UNION ALL SELECT NULL, 2.5, 'b' UNION ALL SELECT 3, 3.5, 'c'"
+
+      {:ok, results} = Connection.query(conn, query)
+
+      assert %Adbc.Result{
+               data: [
+                 %Adbc.Column{
+                   name: "num",
+                   type: :s64,
+                   length: 3,
+                   data: %{
+                     values: <<1::little-64, _::binary-size(8), 3::little-64>>,
+                     validity: <<_::5, 0b101::3>>
+                   }
+                 } = num,
+                 %Adbc.Column{
+                   name: "float",
+                   type: :f64,
+                   length: 3,
+                   data: %{
+                     values: <<1.5::float-little-64, 2.5::float-little-64, 3.5::float-little-64>>,
+                     validity: nil
+                   }
+                 } = float,
+                 %Adbc.Column{name: "text", data: ["a", "b", "c"]}
+               ]
+             } = Adbc.Result.materialize(results, packed: true)
+
+      assert Adbc.Column.to_list(num) == [1, nil, 3]
+      assert Adbc.Column.to_list(float) == [1.5, 2.5, 3.5]
+    end
+
+    test "select with rebatch", %{db: db} do
+      query = """
+      WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 3000)
+      SELECT n FROM seq
+      """
+
+      # the driver emits batches of 1024 rows
+      conn = start_supervised!({Connection, database: db, rebatch: false}, id: :unbatched)
+      {:ok, unbatched} = Connection.query(conn, query)
+      assert %Adbc.Result{data: [%Adbc.Column{data: refs}]} = unbatched
+      assert length(refs) == 3
+
+      # the batches are read in two calls, but are not merged and
+      # still have one record each
+      conn =
+        start_supervised!({Connection, database: db, rebatch: [target_rows: 2048]},
+          id: :rebatched
+        )
+
+      {:ok, rebatched} = Connection.query(conn, query)
+      assert %Adbc.Result{data: [%Adbc.Column{data: refs}]} = rebatched
+      assert length(refs) == 3
+
+      assert Adbc.Result.materialize(rebatched) == Adbc.Result.materialize(unbatched)
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: data}]} = Adbc.Result.materialize(rebatched)
+      assert data == Enum.to_list(1..3000)
+
+      # a batch that would exceed the target is kept for the next call
+      conn =
+        start_supervised!({Connection, database: db, rebatch: [target_rows: 1500]},
+          id: :clamped
+        )
+
+      {:ok, clamped} = Connection.query(conn, query)
+      assert Adbc.Result.materialize(clamped) == Adbc.Result.materialize(unbatched)
+    end
+
+    test "select without rebatch by default", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      query = """
+      WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 3000)
+      SELECT n FROM seq
+      """
+
+      {:ok, result} = Connection.query(conn, query)
+      assert %Adbc.Result{data: [%Adbc.Column{data: refs}]} = result
+      assert length(refs) == 3
+    end
+
+    test "select with prefetch", %{db: db} do
+      conn = start_supervised!({Connection, database: db, prefetch: 2, rebatch: false})
+
+      query = """
+      WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 5000)
+      SELECT n FROM seq
+      """
+
+      {:ok, results} = Connection.query(conn, query)
+      assert %Adbc.Result{data: [%Adbc.Column{data: data}]} = Adbc.Result.materialize(results)
+      assert data == Enum.to_list(1..5000)
+
+      # the connection can run other queries once the stream is released
+      assert {:ok, %Adbc.Result{}} = Connection.query(conn, "SELECT 1")
+    end
+
+    test "executes statements on the native executor", %{db: db} do
+      conns = for i <- 1..4, do: start_supervised!({Connection, database: db}, id: {:conn, i})
+
+      results =
+        conns
+        |> Task.async_stream(fn conn -> Connection.query(conn, "SELECT 123 AS num") end)
+        |> Enum.map(fn {:ok, {:ok, result}} -> Adbc.Result.materialize(result) end)
+
+      for result <- results do
+        assert %Adbc.Result{data: [%Adbc.Column{name: "num", data: [123]}]} = result
+      end
+
+      # errors of the driver are replied by the executor too
+      assert {:error, %Adbc.Error{}} = Connection.query(hd(conns), "SELECT * FROM missing")
+      assert {:ok, %Adbc.Result{}} = Connection.query(hd(conns), "SELECT 1")
+    end
+
+    test "select materializes multi-chunk columns in slices", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      # 40 driver batches, more rows than are decoded in one slice
+      query = """
+      WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 40000)
+      SELECT n, 'row ' || n AS text FROM seq
+      """
+
+      {:ok, %Adbc.Result{data: [n, text]}} = Connection.query(conn, query)
+      assert length(n.data) == 40
+
+      assert %Adbc.Column{data: data} = Adbc.Column.materialize(n)
+      assert data == Enum.to_list(1..40000)
+
+      assert %Adbc.Column{data: data} = Adbc.Column.materialize(text)
+      assert data == Enum.map(1..40000, &"row #{&1}")
+    end
+
+    test "select materializes wide results in parallel", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      query = """
+      WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM seq WHERE n < 70000)
+      SELECT n, n * 0.5 AS half, 'row ' || n AS text FROM seq
+      """
+
+      {:ok, results} = Connection.query(conn, query)
+
+      assert %Adbc.Result{data: [n, half, text]} = Adbc.Result.materialize(results)
+      assert n.data == Enum.to_list(1..70000)
+      assert half.data == Enum.map(1..70000, &(&1 * 0.5))
+      assert text.data == Enum.map(1..70000, &"row #{&1}")
+
+      assert Enum.map(results.data, &Adbc.Column.materialize/1) == [n, half, text]
+    end
   end
 
   describe "query!" do
@@ -1030,5 +1209,39 @@ defmodule Adbc.ConnectionTest do
       assert map["id"] == [10, 20, 30]
       assert map["code"] == ["X", "Y", "Z"]
     end
+
+    test "inserts packed columns", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      ids = for id <- 1..100, into: <<>>, do: <<id::signed-little-64>>
+      scores = for id <- 1..100, into: <<>>, do: <<id / 4::float-little-64>>
+      # every fourth score is null
+      validity = :binary.copy(<<0b11101110>>, 13)
+
+      columns = [
+        Adbc.Column.packed(:s64, ids, name: "id"),
+        Adbc.Column.packed(:f64, scores, name: "score", validity: validity)
+      ]
+
+      assert {:ok, 100} = Connection.bulk_insert(conn, columns, table: "packed")
+
+      {:ok, result} = Connection.query(conn, "SELECT * FROM packed ORDER BY id")
+      map = result |> Adbc.Result.materialize() |> Adbc.Result.to_map()
+
+      assert map["id"] == Enum.to_list(1..100)
+
+      expected = for id <- 1..100, do: if(rem(id - 1, 4) == 0, do: nil, else: id / 4)
+      assert map["score"] == expected
+    end
+
+    test "rejects packed values of the wrong size" do
+      assert_raise Adbc.Error, ~r"multiple of 4 bytes", fn ->
+        Adbc.Column.packed(:s32, <<1, 2, 3>>)
+      end
+
+      assert_raise Adbc.Error, ~r"not supported", fn ->
+        Adbc.Column.packed(:string, "abc")
+      end
+    end
   end
 end
@@ -52,6 +52,187 @@ defmodule Adbc.DuckDBTest do
            } = Adbc.Connection.query!(conn, "SELECT struct_pack(col1 := 1, col2 := 2)")
   end
 
+  test "string views", %{conn: conn} do
+    Connection.query!(conn, "SET produce_arrow_string_view = true")
+
+    query = """
+    SELECT s FROM (VALUES ('short'), ('a string longer than twelve bytes'), (NULL), ('')) t(s)
+    """
+
+    long = "a string longer than twelve bytes"
+
+    # empty values are nil, as they are for :string columns
+    assert %Adbc.Result{
+             data: [%Adbc.Column{name: "s", type: :string_view, data: ["short", ^long, nil, nil]}]
+           } = conn |> Connection.query!(query) |> Adbc.Result.materialize()
+
+    assert %Adbc.Result{
+             data: [%Adbc.Column{name: "s", type: :string_view, data: ["short", ^long, nil, nil]}]
+           } = conn |> Connection.query!(query) |> Adbc.Result.materialize(zero_copy: true)
+
+    Connection.query!(conn, "SET produce_arrow_string_view = false")
+
+    assert %Adbc.Result{
+             data: [%Adbc.Column{name: "s", type: :string, data: ["short", ^long, nil, nil]}]
+           } = conn |> Connection.query!(query) |> Adbc.Result.materialize()
+  end
+
+  test "binds string views", %{conn: conn} do
+    payload = String.duplicate("0123456789", 100)
+    <<first::binary-size(400), second::binary-size(600)>> = payload
+    values = ["short", first, nil, second, payload, ["an iolist ", "longer than twelve bytes"]]
+
+    column = Adbc.Column.string_view(values, name: "s", nullable: true)
+    assert {:ok, 6} = Connection.bulk_insert(conn, [column], table: "string_views")
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: data}]} =
+             conn
+             |> Connection.query!("SELECT s FROM string_views")
+             |> Adbc.Result.materialize()
+
+    assert data == Enum.map(values, &(&1 && IO.iodata_to_binary(&1)))
+  end
+
+  test "binds half floats rounded to nearest even", %{conn: conn} do
+    # 11 values, so that both the 8-wide and the 4-wide conversions have a tail
+    values = [
+      1.0,
+      # halfway between 1.0 and the next half float, rounds to the even 1.0
+      1.00048828125,
+      # halfway between 1.0009765625 and 1.001953125, rounds to the even 1.001953125
+      1.00146484375,
+      65504.0,
+      65519.0,
+      # 65520.0 and above overflow to infinity
+      65520.0,
+      -1.0e6,
+      :nan,
+      nil,
+      # the smallest subnormal, 2^-24
+      5.960464477539063e-8,
+      # 2^-25, halfway between 0 and 2^-24, rounds to the even 0
+      2.9802322387695312e-8
+    ]
+
+    column = Adbc.Column.f16(values, name: "h", nullable: true)
+    assert {:ok, 11} = Connection.bulk_insert(conn, [column], table: "halfs")
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: data}]} =
+             conn
+             |> Connection.query!("SELECT CAST(h AS FLOAT) AS h FROM halfs")
+             |> Adbc.Result.materialize()
+
+    assert data == [
+             1.0,
+             1.0,
+             1.001953125,
+             65504.0,
+             65504.0,
+             :infinity,
+             :neg_infinity,
+             :nan,
+             nil,
+             5.960464477539063e-8,
+             0.0
+           ]
+  end
+
+  test "binds calendar types outside the range of time_t", %{conn: conn} do
+    times = [~T[00:00:00], ~T[12:30:00.5], ~T[23:59:59.999999]]
+
+    columns = [
+      Adbc.Column.date32([~D[1600-02-29], ~D[1969-12-31], ~D[9999-12-31]], name: "d"),
+      Adbc.Column.time(times, :microseconds, name: "t"),
+      Adbc.Column.timestamp(
+        [~N[1600-02-29 00:00:00], ~N[1900-01-01 00:00:00.000001], ~N[9999-12-31 23:59:59]],
+        :microseconds,
+        "UTC",
+        name: "ts"
+      )
+    ]
+
+    assert {:ok, 3} = Connection.bulk_insert(conn, columns, table: "calendar")
+
+    query = """
+    SELECT CAST(d AS VARCHAR) AS d, CAST(t AS VARCHAR) AS t, epoch_us(ts) AS ts FROM calendar
+    """
+
+    assert %{
+             "d" => ["1600-02-29", "1969-12-31", "9999-12-31"],
+             "t" => ["00:00:00", "12:30:00.5", "23:59:59.999999"],
+             "ts" => [-11_670_998_400_000_000, -2_208_988_799_999_999, 253_402_300_799_000_000]
+           } =
+             conn
+             |> Connection.query!(query)
+             |> Adbc.Result.materialize()
+             |> Adbc.Result.to_map()
+  end
+
+  test "execute_many infers calendar, decimal and column parameters", %{conn: conn} do
+    Connection.query!(
+      conn,
+      "CREATE TABLE params (d DATE, t TIME, ts TIMESTAMP, n DECIMAL(10, 2), s SMALLINT)"
+    )
+
+    rows = [
+      {~D[1600-02-29], ~T[12:30:00.5], ~N[1900-01-01 00:00:00.000001], Decimal.new("1.5"),
+       Adbc.Column.s16([1])},
+      {nil, nil, nil, nil, nil},
+      {~D[9999-12-31], ~T[23:59:59.999999], ~N[9999-12-31 23:59:59], Decimal.new("-12.25"),
+       Adbc.Column.s16([-2])}
+    ]
+
+    assert {:ok, _} =
+             Connection.execute_many(conn, "INSERT INTO params VALUES (?, ?, ?, ?, ?)", rows)
+
+    query = """
+    SELECT CAST(d AS VARCHAR) AS d, CAST(t AS VARCHAR) AS t, epoch_us(ts) AS ts,
+           CAST(n AS VARCHAR) AS n, s
+    FROM params
+    """
+
+    assert %{
+             "d" => ["1600-02-29", nil, "9999-12-31"],
+             "t" => ["12:30:00.5", nil, "23:59:59.999999"],
+             "ts" => [-2_208_988_799_999_999, nil, 253_402_300_799_000_000],
+             "n" => ["1.50", nil, "-12.25"],
+             "s" => [1, nil, -2]
+           } =
+             conn
+             |> Connection.query!(query)
+             |> Adbc.Result.materialize()
+             |> Adbc.Result.to_map()
+
+    assert {:error, %ArgumentError{message: message}} =
+             Connection.execute_many(conn, "INSERT INTO params (s) VALUES (?)", [
+               {Adbc.Column.s16([1])},
+               {Adbc.Column.s32([2])}
+             ])
+
+    assert message =~ "is not an `Adbc.Column` with one value of the type `s16`"
+  end
+
+  test "expands enums", %{conn: conn} do
+    query = """
+    SELECT CAST(s AS ENUM('ok', 'failed')) AS status
+    FROM (VALUES ('ok'), ('failed'), (NULL), ('ok')) t(s)
+    """
+
+    assert {:ok, results} = Connection.query(conn, query)
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "status", type: :string, data: ["ok", "failed", nil, "ok"]}
+             ]
+           } = Adbc.Result.materialize(results, expand_dictionary: true)
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "status", type: :string, data: ["ok", "failed", nil, "ok"]}
+             ]
+           } = Adbc.Result.materialize(results, expand: true)
+  end
+
   @tag :unix
   test "decimal128", %{conn: conn} do
     d1 = Decimal.new("1.2345678912345678912345678912345678912")
@@ -176,6 +357,81 @@ defmodule Adbc.DuckDBTest do
            } = Adbc.Result.materialize(results)
   end
 
+  test "maps", %{conn: conn} do
+    query = """
+    SELECT m FROM (VALUES
+      (MAP {'a': 1, 'b': 2}),
+      (NULL),
+      (MAP {}),
+      (MAP {'c': NULL})
+    ) t(m)
+    """
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{
+                 name: "m",
+                 type: :map,
+                 data: [%{"a" => 1, "b" => 2}, nil, %{}, %{"c" => nil}]
+               }
+             ]
+           } = conn |> Connection.query!(query) |> Adbc.Result.materialize(maps: true)
+  end
+
+  test "interns repeated strings", %{conn: conn} do
+    query = """
+    SELECT CASE WHEN i % 2 = 0 THEN 'even' ELSE 'odd' END AS parity FROM range(6) t(i)
+    """
+
+    result = Connection.query!(conn, query)
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: [even, odd, even2, odd2 | _]}]} =
+             Adbc.Result.materialize(result, intern_strings: true)
+
+    assert {even, odd} == {"even", "odd"}
+    assert :erts_debug.same(even, even2)
+    assert :erts_debug.same(odd, odd2)
+  end
+
+  test "to_rows", %{conn: conn} do
+    query = """
+    SELECT i, s FROM (VALUES (1, 'one'), (2, NULL), (3, 'three'), (4, 'four')) t(i, s)
+    """
+
+    result = Connection.query!(conn, query)
+    assert Adbc.Result.to_rows(result) == [{1, "one"}, {2, nil}, {3, "three"}, {4, "four"}]
+    assert Adbc.Result.to_rows(result, offset: 1, limit: 2) == [{2, nil}, {3, "three"}]
+    assert Adbc.Result.to_rows(result, offset: 10) == []
+
+    assert Adbc.Result.to_rows(result, as: :map, limit: 1) == [%{"i" => 1, "s" => "one"}]
+  end
+
+  test "decimals around 64 bits", %{conn: conn} do
+    query = """
+    SELECT d FROM (VALUES
+      (9223372036854775807::DECIMAL(38, 0)),
+      (9223372036854775808::DECIMAL(38, 0)),
+      (-9223372036854775808::DECIMAL(38, 0)),
+      (-18446744073709551616::DECIMAL(38, 0)),
+      (0::DECIMAL(38, 0)),
+      (NULL)
+    ) t(d)
+    """
+
+    assert %Adbc.Result{
+             data: [%Adbc.Column{name: "d", type: {:decimal, 128, 38, 0}, data: data}]
+           } = conn |> Connection.query!(query) |> Adbc.Result.materialize()
+
+    assert data == [
+             Decimal.new(1, 9_223_372_036_854_775_807, 0),
+             Decimal.new(1, 9_223_372_036_854_775_808, 0),
+             Decimal.new(-1, 9_223_372_036_854_775_808, 0),
+             Decimal.new(-1, 18_446_744_073_709_551_616, 0),
+             Decimal.new(1, 0, 0),
+             nil
+           ]
+  end
+
   @tag :unix
   @describetag driver: :duckdb
   test "array handling", %{conn: conn} do
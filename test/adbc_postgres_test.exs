@@ -225,6 +225,25 @@ defmodule Adbc.PostgresTest do
            } = Adbc.Result.materialize(results)
   end
 
+  test "select with temporal types outside of the unix epoch", %{conn: conn} do
+    query = """
+    select
+      '1969-12-31T23:59:59.999999'::timestamp as datetime,
+      '1600-02-29'::date as date,
+      '9999-12-31'::date as max_date
+    """
+
+    assert {:ok, results} = Connection.query(conn, query)
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "datetime", data: [~N[1969-12-31 23:59:59.999999]]},
+               %Adbc.Column{name: "date", data: [~D[1600-02-29]]},
+               %Adbc.Column{name: "max_date", data: [~D[9999-12-31]]}
+             ]
+           } = Adbc.Result.materialize(results)
+  end
+
   test "inf/-inf/nan", %{db: _, conn: conn} do
     assert {:ok, results} =
              Adbc.Connection.query(
@@ -94,4 +94,12 @@ defmodule Adbc.ResultTest do
              "time_series" => [[[1], [2, 3], [3, 4], [4]], [[3, 4], [4], [5, 6], [6]]]
            } == Result.to_map(result())
   end
+
+  test "to_rows with materialized columns" do
+    assert [{~N[2024-05-31 12:30:00], ~N[2024-05-31 13:30:00], _}] =
+             Result.to_rows(result(), offset: 1)
+
+    assert [%{"start_time" => ~N[2024-05-31 12:00:00], "end_time" => ~N[2024-05-31 13:00:00]}] =
+             Result.to_rows(result(), as: :map, limit: 1)
+  end
 end
@@ -410,4 +410,50 @@ defmodule Adbc.SQLiteTest do
              ]
            } = Adbc.Result.materialize(results)
   end
+
+  test "execute_many", %{db: _, conn: conn} do
+    rows =
+      for i <- 1..1000 do
+        {i, if(rem(i, 3) == 0, do: nil, else: "row #{i}"), i / 2, rem(i, 2) == 0, nil}
+      end
+
+    assert {:ok, _} =
+             Connection.execute_many(
+               conn,
+               "INSERT INTO test (i1, t1, r1, n3, n1) VALUES (?, ?, ?, ?, ?)",
+               [[0, "first", 0.0, false, nil] | rows]
+             )
+
+    assert %{"count" => [1001], "t1" => [668], "r1" => [sum], "n3" => [500]} =
+             conn
+             |> Connection.query!(
+               "SELECT COUNT(*) AS count, COUNT(t1) AS t1, SUM(r1) AS r1, SUM(n3) AS n3 FROM test"
+             )
+             |> Adbc.Result.materialize()
+             |> Adbc.Result.to_map()
+
+    assert sum == 250_250.0
+
+    assert {:ok, 0} = Connection.execute_many(conn, "INSERT INTO test (i1) VALUES (?)", [])
+  end
+
+  test "execute_many with invalid rows", %{db: _, conn: conn} do
+    query = "INSERT INTO test (i1, t1) VALUES (?, ?)"
+
+    assert {:error, %ArgumentError{message: message}} =
+             Connection.execute_many(conn, query, [{1, "a"}, {2}])
+
+    assert message =~ "expected row 1 to have 2 parameters"
+
+    assert {:error, %ArgumentError{message: message}} =
+             Connection.execute_many(conn, query, [{1, "a"}, {"b", "c"}])
+
+    assert message =~ "parameter `<<\"b\">>` in row 1 does not have the type int64"
+
+    assert %{"count" => [0]} =
+             conn
+             |> Connection.query!("SELECT COUNT(*) AS count FROM test")
+             |> Adbc.Result.materialize()
+             |> Adbc.Result.to_map()
+  end
 end